@@ -0,0 +1,89 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "bench_fixed_batch.h"
+#include "bench_fixed_int.h"
+#include "bench_fixed_trig.h"
+#include "bench_fixed_vec.h"
+#include "bench_grid_walking.h"
+#include "bench_spatial_grid.h"
+#include "benchmark.h"
+
+namespace {
+
+bool ParseFlag(std::string const& arg,
+               std::string const& flag,
+               std::string& value) {
+  std::string prefix = "--" + flag + "=";
+  if (arg.compare(0, prefix.size(), prefix) != 0) {
+    return false;
+  }
+  value = arg.substr(prefix.size());
+  return true;
+}
+
+void PrintUsage(char const* program) {
+  printf(
+      "usage: %s [--benchmark_filter=<substring>]\n"
+      "          [--benchmark_min_time=<seconds>]\n"
+      "          [--benchmark_format=<console|json>]\n"
+      "          [--benchmark_out=<file.json>]\n",
+      program);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string filter;
+  std::string format = "console";
+  std::string out;
+  double min_time = 0.2;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    std::string value;
+    if (ParseFlag(arg, "benchmark_filter", value)) {
+      filter = value;
+    } else if (ParseFlag(arg, "benchmark_min_time", value)) {
+      min_time = std::atof(value.c_str());
+    } else if (ParseFlag(arg, "benchmark_format", value)) {
+      format = value;
+    } else if (ParseFlag(arg, "benchmark_out", value)) {
+      out = value;
+    } else {
+      PrintUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (format != "console" && format != "json") {
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  // With the JSON format, the progress goes to stderr so that stdout only
+  // contains JSON.
+  dux_bench::Runner runner(filter, min_time,
+                           format == "json" ? std::cerr : std::cout);
+  runner.PrintConsoleHeader();
+  BenchFInt(runner);
+  BenchBatch(runner);
+  BenchTrig(runner);
+  BenchFVec(runner);
+  BenchGridWalking(runner);
+  BenchSpatialGrid(runner);
+
+  if (format == "json") {
+    runner.PrintJson(std::cout);
+  }
+  if (!out.empty()) {
+    std::ofstream out_stream(out);
+    if (!out_stream) {
+      fprintf(stderr, "could not open %s\n", out.c_str());
+      return EXIT_FAILURE;
+    }
+    runner.PrintJson(out_stream);
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,96 @@
+#include "bench_fixed_batch.h"
+
+#include <string>
+
+using namespace dux;
+using namespace dux_bench;
+
+void BenchBatch(Runner& runner) {
+  auto a = RandFInts(kInputCount, -1000_fx, 1000_fx);
+  auto b = RandFInts(kInputCount, 1_fx, 1000_fx);
+  std::vector<FInt::RawType> raw_a;
+  std::vector<FInt::RawType> raw_b;
+  for (size_t i = 0; i < kInputCount; i++) {
+    raw_a.push_back(a[i].raw_value_);
+    raw_b.push_back(b[i].raw_value_);
+  }
+  std::vector<FInt::RawType> out(kInputCount);
+
+  // The same operations, one |FInt| operator call at a time.
+  runner.Run(
+      "Batch/Mul/loop",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          for (size_t j = 0; j < kInputCount; j++) {
+            out[j] = (a[j] * b[j]).raw_value_;
+          }
+          DoNotOptimize(out.data());
+        }
+      },
+      kInputCount);
+
+  batch::Backend default_backend = batch::ActiveBackend();
+  for (batch::Backend backend :
+       {batch::Backend::kScalar, batch::Backend::kSse42,
+        batch::Backend::kAvx2}) {
+    if (!batch::IsBackendSupported(backend)) {
+      continue;
+    }
+    batch::SetActiveBackend(backend);
+    std::string suffix = std::string("/") + batch::BackendName(backend);
+    auto run_binary = [&](std::string const& name,
+                          void (*op)(FInt::RawType const*,
+                                     FInt::RawType const*, FInt::RawType*,
+                                     size_t)) {
+      runner.Run(
+          "Batch/" + name + suffix,
+          [&](int64_t iterations) {
+            for (int64_t i = 0; i < iterations; i++) {
+              op(raw_a.data(), raw_b.data(), out.data(), kInputCount);
+              DoNotOptimize(out.data());
+            }
+          },
+          kInputCount);
+    };
+    auto run_unary = [&](std::string const& name,
+                         void (*op)(FInt::RawType const*, FInt::RawType*,
+                                    size_t)) {
+      runner.Run(
+          "Batch/" + name + suffix,
+          [&](int64_t iterations) {
+            for (int64_t i = 0; i < iterations; i++) {
+              op(raw_a.data(), out.data(), kInputCount);
+              DoNotOptimize(out.data());
+            }
+          },
+          kInputCount);
+    };
+    run_binary("Add", batch::Add);
+    run_binary("Mul", batch::Mul);
+    run_binary("Div", batch::Div);
+    runner.Run(
+        "Batch/MulInt" + suffix,
+        [&](int64_t iterations) {
+          for (int64_t i = 0; i < iterations; i++) {
+            batch::MulInt(raw_a.data(), 3, out.data(), kInputCount);
+            DoNotOptimize(out.data());
+          }
+        },
+        kInputCount);
+    run_unary("Round", batch::Round);
+    run_unary("Abs", batch::Abs);
+  }
+  batch::SetActiveBackend(default_backend);
+
+  // Uses the same code with all the backends.
+  runner.Run(
+      "Batch/DivFInt",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          batch::DivFInt(raw_a.data(), b[i & kInputMask], out.data(),
+                         kInputCount);
+          DoNotOptimize(out.data());
+        }
+      },
+      kInputCount);
+}
@@ -0,0 +1,236 @@
+#include "bench_fixed_int.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace dux;
+using namespace dux_bench;
+
+namespace {
+
+// Returns the largest and the root mean square errors of |function(i)|
+// compared to |exact(i)|, for i in [0, kInputCount[, in units of the smallest
+// |FInt|. Also returns the largest relative error.
+template <typename Function, typename Exact>
+Counters Errors(Function function, Exact exact) {
+  double max_error = 0;
+  double sum_of_squares = 0;
+  double max_relative_error = 0;
+  for (size_t i = 0; i < kInputCount; i++) {
+    double expected = exact(i);
+    double error = std::abs(function(i).DoubleValue() - expected);
+    max_relative_error =
+        std::max(max_relative_error, error / std::abs(expected));
+    error *= 1 << FInt::kShift;
+    max_error = std::max(max_error, error);
+    sum_of_squares += error * error;
+  }
+  return {{"max_error_ulp", max_error},
+          {"rms_error_ulp", std::sqrt(sum_of_squares / kInputCount)},
+          {"max_relative_error", max_relative_error}};
+}
+
+}  // namespace
+
+void BenchFInt(Runner& runner) {
+  // Values that fit in an int32_t once converted to their raw value, which
+  // take the fast path of |Sqrt|.
+  auto small = RandFInts(kInputCount, 0_fx, 500000_fx);
+  // Values covering the rest of the positive range.
+  auto large = RandFInts(kInputCount, 1000000_fx, FIntMax / 2);
+  auto signed_values = RandFInts(kInputCount, -1000_fx, 1000_fx);
+  auto divisors = RandFInts(kInputCount, 1_fx, 1000_fx);
+  auto exponents = RandFInts(kInputCount, -8_fx, 8_fx);
+  auto logarithms = RandFInts(kInputCount, FInt::FromFraction(1, 100), 1000_fx);
+  auto bases = RandFInts(kInputCount, 1_fx, 10_fx);
+  auto integral_powers = RandFInts(kInputCount, 0_fx, 4_fx);
+  for (FInt& p : integral_powers) {
+    p = p.Floor();
+  }
+  auto fractional_powers = RandFInts(kInputCount, 0_fx, 4_fx);
+
+  runner.Run("FInt/Mul", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(signed_values[i & kInputMask] *
+                    signed_values[(i + 1) & kInputMask]);
+    }
+  });
+  runner.Run("FInt/Div", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(signed_values[i & kInputMask] /
+                    divisors[i & kInputMask]);
+    }
+  });
+  // The cost of the 128-bit intermediate results, which are used by
+  // |operator*| and |operator/| when DUX_FIXED_WIDE_ARITHMETIC is defined.
+  runner.Run("FInt/MulWide", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(signed_values[i & kInputMask].MulWide(
+          signed_values[(i + 1) & kInputMask]));
+    }
+  });
+  runner.Run("FInt/DivWide", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(
+          signed_values[i & kInputMask].DivWide(divisors[i & kInputMask]));
+    }
+  });
+  runner.Run("FInt/CheckedMul", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(signed_values[i & kInputMask].CheckedMul(
+          signed_values[(i + 1) & kInputMask]));
+    }
+  });
+  runner.Run("FInt/SaturatingMul", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(signed_values[i & kInputMask].SaturatingMul(
+          signed_values[(i + 1) & kInputMask]));
+    }
+  });
+  runner.Run("FInt/SaturatingAdd", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(signed_values[i & kInputMask].SaturatingAdd(
+          signed_values[(i + 1) & kInputMask]));
+    }
+  });
+  // Dividends that do not fit in 64 bits once shifted.
+  runner.Run("FInt/DivWide/large", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(large[i & kInputMask].DivWide(divisors[i & kInputMask]));
+    }
+  });
+  FIntDivisor const divisor(divisors[0]);
+  runner.Run("FInt/Div/FIntDivisor", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(divisor.Divide(signed_values[i & kInputMask]));
+    }
+  });
+  runner.Run("FIntDivisor/Create", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(FIntDivisor(divisors[i & kInputMask]));
+    }
+  });
+  runner.Run("FInt/Round", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(signed_values[i & kInputMask].Round());
+    }
+  });
+  runner.Run("FInt/EuclideanDivisionRemainder", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(
+          signed_values[i & kInputMask].EuclideanDivisionRemainder(64_fx));
+    }
+  });
+  runner.Run("FInt/Sqrt/small", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(small[i & kInputMask].Sqrt());
+    }
+  });
+  runner.Run("FInt/Sqrt/large", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(large[i & kInputMask].Sqrt());
+    }
+  });
+  runner.Run("FInt/InvSqrt", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(divisors[i & kInputMask].InvSqrt());
+    }
+  });
+  runner.Run("FInt/InvSqrt/division", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(1_fx / divisors[i & kInputMask].Sqrt());
+    }
+  });
+  // The errors are measured against the exact results for the rounded
+  // inputs.
+  auto exp_errors = [&](auto exp) {
+    return Errors([&](size_t i) { return exp(exponents[i]); },
+                  [&](size_t i) { return std::exp(exponents[i].DoubleValue()); });
+  };
+  auto ln_errors = [&](auto ln) {
+    return Errors(
+        [&](size_t i) { return ln(logarithms[i]); },
+        [&](size_t i) { return std::log(logarithms[i].DoubleValue()); });
+  };
+  auto pow_errors = [&](auto pow, std::vector<FInt> const& powers) {
+    return Errors([&](size_t i) { return pow(bases[i], powers[i]); },
+                  [&](size_t i) {
+                    return std::pow(bases[i].DoubleValue(),
+                                    powers[i].DoubleValue());
+                  });
+  };
+  auto exp = [](FInt x) { return Exp(x); };
+  auto fast_exp = [](FInt x) { return FastExp(x); };
+  auto ln = [](FInt x) { return Ln(x); };
+  auto fast_ln = [](FInt x) { return FastLn(x); };
+  auto pow = [](FInt x, FInt y) { return Pow(x, y); };
+  auto fast_pow = [](FInt x, FInt y) { return FastPow(x, y); };
+  runner.Run(
+      "FInt/Exp",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          DoNotOptimize(Exp(exponents[i & kInputMask]));
+        }
+      },
+      1, exp_errors(exp));
+  runner.Run(
+      "FInt/FastExp",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          DoNotOptimize(FastExp(exponents[i & kInputMask]));
+        }
+      },
+      1, exp_errors(fast_exp));
+  runner.Run(
+      "FInt/Ln",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          DoNotOptimize(Ln(logarithms[i & kInputMask]));
+        }
+      },
+      1, ln_errors(ln));
+  runner.Run(
+      "FInt/FastLn",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          DoNotOptimize(FastLn(logarithms[i & kInputMask]));
+        }
+      },
+      1, ln_errors(fast_ln));
+  runner.Run(
+      "FInt/Pow/integral",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          DoNotOptimize(
+              Pow(bases[i & kInputMask], integral_powers[i & kInputMask]));
+        }
+      },
+      1, pow_errors(pow, integral_powers));
+  runner.Run(
+      "FInt/FastPow/integral",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          DoNotOptimize(
+              FastPow(bases[i & kInputMask], integral_powers[i & kInputMask]));
+        }
+      },
+      1, pow_errors(fast_pow, integral_powers));
+  runner.Run(
+      "FInt/Pow/fractional",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          DoNotOptimize(
+              Pow(bases[i & kInputMask], fractional_powers[i & kInputMask]));
+        }
+      },
+      1, pow_errors(pow, fractional_powers));
+  runner.Run(
+      "FInt/FastPow/fractional",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          DoNotOptimize(FastPow(bases[i & kInputMask],
+                                fractional_powers[i & kInputMask]));
+        }
+      },
+      1, pow_errors(fast_pow, fractional_powers));
+}
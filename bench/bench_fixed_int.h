@@ -0,0 +1,8 @@
+#ifndef DUX_FIXED_BENCH_BENCH_FINT_H_
+#define DUX_FIXED_BENCH_BENCH_FINT_H_
+
+#include "benchmark.h"
+
+void BenchFInt(dux_bench::Runner& runner);
+
+#endif  // DUX_FIXED_BENCH_BENCH_FINT_H_
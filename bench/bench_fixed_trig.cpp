@@ -0,0 +1,256 @@
+#include "bench_fixed_trig.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+using namespace dux;
+using namespace dux_bench;
+
+namespace {
+
+// Returns the largest and the root mean square errors of the sinus and
+// cosinus of |Trig| over all the angles in [0, 2*PI], in units of the
+// smallest |FInt|.
+template <typename Trig>
+Counters SincosErrors() {
+  double max_error = 0;
+  double sum_of_squares = 0;
+  int64_t count = 0;
+  for (int64_t raw = 0; raw <= FIntTwoPi.raw_value_; raw++) {
+    FInt angle = FInt::FromRawValue(raw);
+    FInt sin;
+    FInt cos;
+    Trig::Sincos(angle, sin, cos);
+    for (double error :
+         {sin.DoubleValue() - std::sin(angle.DoubleValue()),
+          cos.DoubleValue() - std::cos(angle.DoubleValue())}) {
+      error *= 1 << FInt::kShift;
+      max_error = std::max(max_error, std::abs(error));
+      sum_of_squares += error * error;
+      count++;
+    }
+  }
+  return {{"max_error_ulp", max_error},
+          {"rms_error_ulp", std::sqrt(sum_of_squares / count)}};
+}
+
+template <uint32_t kSegments, trig::Interpolation kInterpolation>
+void BenchTableTrig(Runner& runner,
+                    std::vector<FInt> const& angles,
+                    std::string const& name) {
+  using Trig = trig::TableTrig<kSegments, kInterpolation>;
+  runner.Run(
+      "Trig/TableTrig/" + std::to_string(kSegments) + "/" + name,
+      [&](int64_t iterations) {
+        FInt sin;
+        FInt cos;
+        for (int64_t i = 0; i < iterations; i++) {
+          Trig::Sincos(angles[i & kInputMask], sin, cos);
+          DoNotOptimize(sin);
+          DoNotOptimize(cos);
+        }
+      },
+      1, SincosErrors<Trig>());
+}
+
+// The original |trig::Atan2|, which binary searched a table of tan values,
+// for comparison.
+std::vector<int32_t> const& LegacyTanTable() {
+  static std::vector<int32_t> const table = [] {
+    std::vector<int32_t> values;
+    for (int i = 0; i < 512; i++) {
+      double angle = i * (2 * M_PI / 512);
+      values.push_back(static_cast<int32_t>(
+          FInt::FromDouble(std::tan(angle / 4)).raw_value_));
+    }
+    return values;
+  }();
+  return table;
+}
+
+uint32_t SearchValueInTanTable(std::vector<int32_t> const& table,
+                               int32_t value) {
+  uint32_t lowerBound = 0;
+  uint32_t higherBound = table.size() - 1;
+  if (value <= table[lowerBound]) {
+    return lowerBound;
+  }
+  if (value >= table[higherBound]) {
+    return higherBound;
+  }
+  while (higherBound - lowerBound > 1) {
+    uint32_t index = (higherBound + lowerBound) / 2;
+    int32_t valueInTheCenter = table[index];
+    if (valueInTheCenter > value) {
+      higherBound = index;
+    } else {
+      if (valueInTheCenter < value) {
+        lowerBound = index;
+      } else {
+        return index;
+      }
+    }
+  }
+  return lowerBound;
+}
+
+FInt LegacyAtan2(std::vector<int32_t> const& table, FInt y, FInt x) {
+  if (x.raw_value_ == 0) {
+    if (y.raw_value_ > 0) {
+      return FIntHalfPi;
+    } else {
+      return FIntPi + FIntHalfPi;
+    }
+  }
+  int32_t d = static_cast<uint32_t>((y / x).raw_value_);
+  d = std::abs(d);
+  FInt angle = FIntHalfPi * FInt::FromInt(SearchValueInTanTable(table, d));
+  angle >>= 9;
+  if (y.raw_value_ > 0) {
+    if (x.raw_value_ > 0) {
+      return angle;
+    } else {
+      return FIntPi - angle;
+    }
+  } else {
+    if (x.raw_value_ > 0) {
+      if (angle == 0_fx) {
+        return 0_fx;
+      }
+      return FIntTwoPi - angle;
+    } else {
+      return FIntPi + angle;
+    }
+  }
+}
+
+// Returns the largest and the root mean square errors of |atan2| over
+// |points|, in units of the smallest |FInt|.
+template <typename Atan2>
+Counters Atan2Errors(std::vector<FVec2> const& points, Atan2 atan2) {
+  double max_error = 0;
+  double sum_of_squares = 0;
+  for (FVec2 const& p : points) {
+    double expected = std::atan2(static_cast<double>(p.y_.raw_value_),
+                                 static_cast<double>(p.x_.raw_value_));
+    double error = std::abs(atan2(p.y_, p.x_).DoubleValue() - expected);
+    error = std::min(error, std::abs(error - 2 * M_PI));
+    error *= 1 << FInt::kShift;
+    max_error = std::max(max_error, error);
+    sum_of_squares += error * error;
+  }
+  return {{"max_error_ulp", max_error},
+          {"rms_error_ulp", std::sqrt(sum_of_squares / points.size())}};
+}
+
+}  // namespace
+
+void BenchTrig(Runner& runner) {
+  auto angles = RandFInts(kInputCount, 0_fx, FIntTwoPi);
+  auto negative_angles = RandFInts(kInputCount, -FIntTwoPi, 0_fx);
+  // Angles accumulated over many ticks, which need a range reduction.
+  auto large_angles = RandFInts(kInputCount, -10000_fx, 10000_fx);
+  auto points = RandFVec2s(kInputCount, -1000_fx, 1000_fx);
+
+  runner.Run("Trig/Cos", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(trig::Cos(angles[i & kInputMask]));
+    }
+  });
+  runner.Run("Trig/Sin", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(trig::Sin(angles[i & kInputMask]));
+    }
+  });
+  runner.Run("Trig/Sincos", [&](int64_t iterations) {
+    FInt sin;
+    FInt cos;
+    for (int64_t i = 0; i < iterations; i++) {
+      trig::Sincos(angles[i & kInputMask], sin, cos);
+      DoNotOptimize(sin);
+      DoNotOptimize(cos);
+    }
+  });
+  runner.Run("Trig/Sincos/negative", [&](int64_t iterations) {
+    FInt sin;
+    FInt cos;
+    for (int64_t i = 0; i < iterations; i++) {
+      trig::Sincos(negative_angles[i & kInputMask], sin, cos);
+      DoNotOptimize(sin);
+      DoNotOptimize(cos);
+    }
+  });
+  runner.Run("Trig/Sincos/large", [&](int64_t iterations) {
+    FInt sin;
+    FInt cos;
+    for (int64_t i = 0; i < iterations; i++) {
+      trig::Sincos(large_angles[i & kInputMask], sin, cos);
+      DoNotOptimize(sin);
+      DoNotOptimize(cos);
+    }
+  });
+  // The accuracy and latency of the table resolutions and interpolations.
+  // The 512 nearest configuration is the one of |trig::Sincos|.
+  BenchTableTrig<256, trig::Interpolation::kNearest>(runner, angles,
+                                                     "nearest");
+  BenchTableTrig<512, trig::Interpolation::kNearest>(runner, angles,
+                                                     "nearest");
+  BenchTableTrig<1024, trig::Interpolation::kNearest>(runner, angles,
+                                                      "nearest");
+  BenchTableTrig<4096, trig::Interpolation::kNearest>(runner, angles,
+                                                      "nearest");
+  BenchTableTrig<256, trig::Interpolation::kLinear>(runner, angles, "linear");
+  BenchTableTrig<512, trig::Interpolation::kLinear>(runner, angles, "linear");
+  BenchTableTrig<1024, trig::Interpolation::kLinear>(runner, angles,
+                                                     "linear");
+  BenchTableTrig<4096, trig::Interpolation::kLinear>(runner, angles,
+                                                     "linear");
+
+  std::vector<FInt> sin(kInputCount);
+  std::vector<FInt> cos(kInputCount);
+  runner.Run(
+      "Trig/SincosN",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          trig::SincosN(angles.data(), sin.data(), cos.data(), kInputCount);
+          DoNotOptimize(sin.data());
+          DoNotOptimize(cos.data());
+        }
+      },
+      kInputCount);
+  runner.Run(
+      "Trig/SincosN/large",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          trig::SincosN(large_angles.data(), sin.data(), cos.data(),
+                        kInputCount);
+          DoNotOptimize(sin.data());
+          DoNotOptimize(cos.data());
+        }
+      },
+      kInputCount);
+  runner.Run(
+      "Trig/Atan2",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          FVec2 const& p = points[i & kInputMask];
+          DoNotOptimize(trig::Atan2(p.y_, p.x_));
+        }
+      },
+      1,
+      Atan2Errors(points, [](FInt y, FInt x) { return trig::Atan2(y, x); }));
+  std::vector<int32_t> const& tan_table = LegacyTanTable();
+  auto legacy_atan2 = [&](FInt y, FInt x) {
+    return LegacyAtan2(tan_table, y, x);
+  };
+  runner.Run(
+      "Trig/Atan2/legacy",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          FVec2 const& p = points[i & kInputMask];
+          DoNotOptimize(legacy_atan2(p.y_, p.x_));
+        }
+      },
+      1, Atan2Errors(points, legacy_atan2));
+}
@@ -0,0 +1,8 @@
+#ifndef DUX_FIXED_BENCH_BENCH_FIXED_TRIG_H_
+#define DUX_FIXED_BENCH_BENCH_FIXED_TRIG_H_
+
+#include "benchmark.h"
+
+void BenchTrig(dux_bench::Runner& runner);
+
+#endif  // DUX_FIXED_BENCH_BENCH_FIXED_TRIG_H_
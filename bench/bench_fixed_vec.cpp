@@ -0,0 +1,285 @@
+#include "bench_fixed_vec.h"
+
+using namespace dux;
+using namespace dux_bench;
+
+void BenchFVec(Runner& runner) {
+  // Vectors whose components are below 0.1, which take the precise path of
+  // |FVec2::Length|.
+  auto tiny = RandFVec2s(kInputCount, -FInt::FromFraction(1, 11),
+                         FInt::FromFraction(1, 11));
+  auto small = RandFVec2s(kInputCount, -100_fx, 100_fx);
+  auto large = RandFVec2s(kInputCount, -100000_fx, 100000_fx);
+  auto angles = RandFInts(kInputCount, -FIntTwoPi, FIntTwoPi);
+  std::vector<FVec3> small3;
+  for (size_t i = 0; i < kInputCount; i++) {
+    small3.emplace_back(small[i].x_, small[i].y_, small[(i + 1) & kInputMask].x_);
+  }
+
+  runner.Run("FVec2/SquareLength", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(small[i & kInputMask].SquareLength());
+    }
+  });
+  runner.Run("FVec2/Length/tiny", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      FVec2 v = tiny[i & kInputMask];
+      DoNotOptimize(v.Length());
+    }
+  });
+  runner.Run("FVec2/Length/small", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      FVec2 v = small[i & kInputMask];
+      DoNotOptimize(v.Length());
+    }
+  });
+  runner.Run("FVec2/Length/large", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      FVec2 v = large[i & kInputMask];
+      DoNotOptimize(v.Length());
+    }
+  });
+  runner.Run("FVec2/Normalize", [&](int64_t iterations) {
+    bool success;
+    for (int64_t i = 0; i < iterations; i++) {
+      FVec2 v = small[i & kInputMask];
+      v.Normalize(success);
+      DoNotOptimize(v);
+    }
+  });
+  runner.Run("FVec2/NormalizeToLength", [&](int64_t iterations) {
+    bool success;
+    for (int64_t i = 0; i < iterations; i++) {
+      FVec2 v = small[i & kInputMask];
+      v.Normalize(success, 10_fx);
+      DoNotOptimize(v);
+    }
+  });
+  runner.Run("FVec2/NormalizeWithDivision", [&](int64_t iterations) {
+    bool success;
+    for (int64_t i = 0; i < iterations; i++) {
+      FVec2 v = small[i & kInputMask];
+      v.NormalizeWithDivision(success);
+      DoNotOptimize(v);
+    }
+  });
+  runner.Run("FVec2/NormalizeToLengthWithDivision", [&](int64_t iterations) {
+    bool success;
+    for (int64_t i = 0; i < iterations; i++) {
+      FVec2 v = small[i & kInputMask];
+      v.NormalizeWithDivision(success, 10_fx);
+      DoNotOptimize(v);
+    }
+  });
+  runner.Run("FVec2/DotProduct", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(small[i & kInputMask].DotProduct(
+          small[(i + 1) & kInputMask]));
+    }
+  });
+  runner.Run("FVec2/Rotate", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      FVec2 v = small[i & kInputMask];
+      v.Rotate(angles[i & kInputMask]);
+      DoNotOptimize(v);
+    }
+  });
+  runner.Run("FVec2/FromAngle", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(FVec2::FromAngle(angles[i & kInputMask], 10_fx));
+    }
+  });
+  std::vector<FVec2> from_angles(kInputCount);
+  runner.Run(
+      "FVec2/FromAngles",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          FVec2::FromAngles(angles.data(), 10_fx, from_angles.data(),
+                            kInputCount);
+          DoNotOptimize(from_angles.data());
+        }
+      },
+      kInputCount);
+  runner.Run("FVec2/Angle", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(small[i & kInputMask].Angle());
+    }
+  });
+  // The particle update loop, one |FVec2| at a time and with |FVec2Array|.
+  FInt dt = FInt::FromFraction(1, 60);
+  std::vector<FVec2> positions = large;
+  runner.Run(
+      "FVec2/Integrate/loop",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          for (size_t j = 0; j < kInputCount; j++) {
+            positions[j] += small[j] * dt;
+          }
+          DoNotOptimize(positions.data());
+        }
+      },
+      kInputCount);
+  FVec2Array position_array;
+  FVec2Array velocity_array;
+  for (size_t i = 0; i < kInputCount; i++) {
+    position_array.PushBack(large[i]);
+    velocity_array.PushBack(small[i]);
+  }
+  std::vector<FInt> lengths(kInputCount);
+  runner.Run(
+      "FVec2Array/Integrate",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          position_array.Integrate(velocity_array, dt);
+          DoNotOptimize(position_array.x_.data());
+        }
+      },
+      kInputCount);
+  runner.Run(
+      "FVec2Array/SquareLength",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          velocity_array.SquareLength(lengths.data());
+          DoNotOptimize(lengths.data());
+        }
+      },
+      kInputCount);
+  runner.Run(
+      "FVec2Array/Length",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          velocity_array.Length(lengths.data());
+          DoNotOptimize(lengths.data());
+        }
+      },
+      kInputCount);
+  runner.Run(
+      "FVec2Array/Normalize",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          FVec2Array normalized = velocity_array;
+          normalized.Normalize(nullptr);
+          DoNotOptimize(normalized.x_.data());
+        }
+      },
+      kInputCount);
+  runner.Run(
+      "FVec2Array/NormalizeWithDivision",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          FVec2Array normalized = velocity_array;
+          normalized.NormalizeWithDivision(nullptr);
+          DoNotOptimize(normalized.x_.data());
+        }
+      },
+      kInputCount);
+  runner.Run(
+      "FVec2Array/Rotate",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          velocity_array.Rotate(angles[i & kInputMask]);
+          DoNotOptimize(velocity_array.x_.data());
+        }
+      },
+      kInputCount);
+  // The same update over a world too large for the caches, with the positions
+  // stored as |FVec2| and as |FVec2_32|.
+  constexpr size_t kWorldSize = 1 << 22;
+  std::vector<FVec2> world(kWorldSize);
+  std::vector<FVec2_32> world_32(kWorldSize);
+  for (size_t i = 0; i < kWorldSize; i++) {
+    world[i] = FVec2(large[i & kInputMask].x_, large[i & kInputMask].y_);
+    world_32[i] = FVec2_32::NarrowSaturated(world[i]);
+  }
+  FVec2 drift = small[0] * dt;
+  runner.Run(
+      "FVec2/Integrate/world",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          for (FVec2& position : world) {
+            position += drift;
+          }
+          DoNotOptimize(world.data());
+        }
+      },
+      kWorldSize);
+  runner.Run(
+      "FVec2_32/Integrate/world",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          for (FVec2_32& position : world_32) {
+            FVec2 widened = position.Widen();
+            widened += drift;
+            position = FVec2_32::NarrowSaturated(widened);
+          }
+          DoNotOptimize(world_32.data());
+        }
+      },
+      kWorldSize);
+
+  // Loops made of many small calls, whose cost depends on whether they are
+  // inlined: compare the runs of a build with DUX_FIXED_HEADER_ONLY to the
+  // ones of a default build.
+  std::vector<FVec2> steering_positions = large;
+  std::vector<FVec2> steering_velocities = small;
+  FInt max_speed = 10_fx;
+  runner.Run(
+      "FVec2/Calls/Steering",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          for (size_t j = 0; j < kInputCount; j++) {
+            FVec2& position = steering_positions[j];
+            FVec2& velocity = steering_velocities[j];
+            FVec2 desired = large[(j + 1) & kInputMask] - position;
+            if (desired.SquareLength() > 1_fx) {
+              desired = desired.Normalized() * max_speed;
+            }
+            FVec2 steering = (desired - velocity) / 8;
+            if (steering.DotProduct(velocity) < 0_fx) {
+              steering.Rotate90Deg();
+            }
+            velocity += steering;
+            position += velocity * dt;
+          }
+          DoNotOptimize(steering_positions.data());
+        }
+      },
+      kInputCount);
+  std::vector<FVec3> forces3(kInputCount);
+  runner.Run(
+      "FVec3/Calls/Springs",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          for (size_t j = 0; j + 1 < kInputCount; j++) {
+            FVec3 delta = small3[j + 1] - small3[j];
+            FInt stretch = delta.SquareLength() - 100_fx;
+            forces3[j] = delta * (stretch / 4096) - small3[j] / 8;
+          }
+          DoNotOptimize(forces3.data());
+        }
+      },
+      kInputCount - 1);
+
+  runner.Run("FVec3/Length", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      FVec3 v = small3[i & kInputMask];
+      DoNotOptimize(v.Length());
+    }
+  });
+  runner.Run("FVec3/Normalize", [&](int64_t iterations) {
+    bool success;
+    for (int64_t i = 0; i < iterations; i++) {
+      FVec3 v = small3[i & kInputMask];
+      v.Normalize(success);
+      DoNotOptimize(v);
+    }
+  });
+  runner.Run("FVec3/NormalizeWithDivision", [&](int64_t iterations) {
+    bool success;
+    for (int64_t i = 0; i < iterations; i++) {
+      FVec3 v = small3[i & kInputMask];
+      v.NormalizeWithDivision(success);
+      DoNotOptimize(v);
+    }
+  });
+}
@@ -0,0 +1,8 @@
+#ifndef DUX_FIXED_BENCH_BENCH_FIXED_VEC_H_
+#define DUX_FIXED_BENCH_BENCH_FIXED_VEC_H_
+
+#include "benchmark.h"
+
+void BenchFVec(dux_bench::Runner& runner);
+
+#endif  // DUX_FIXED_BENCH_BENCH_FIXED_VEC_H_
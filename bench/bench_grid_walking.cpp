@@ -0,0 +1,259 @@
+#include "bench_grid_walking.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "grid_walking.h"
+#include "line_of_sight.h"
+#include "thread_pool.h"
+
+using namespace dux;
+using namespace dux_bench;
+
+namespace {
+
+constexpr GridSize kGridSize = {1 << 15, 1 << 15};
+
+struct Ray {
+  FVec2 start_;
+  FVec2 end_;
+};
+
+// Returns rays starting around the middle of the grid, and whose length is at
+// most |max_length|.
+std::vector<Ray> RandRays(FInt max_length) {
+  FInt center = FInt::FromInt(64 * (1 << 14));
+  auto starts = RandFVec2s(kInputCount, center - 1000_fx, center + 1000_fx);
+  auto offsets = RandFVec2s(kInputCount, -max_length, max_length);
+  std::vector<Ray> rays;
+  for (size_t i = 0; i < kInputCount; i++) {
+    rays.push_back({starts[i], starts[i] + offsets[i]});
+  }
+  return rays;
+}
+
+}  // namespace
+
+void BenchGridWalking(Runner& runner) {
+  auto positions = RandFVec2s(kInputCount, 0_fx, 1000000_fx);
+  // Line-of-sight checks between nearby units.
+  auto short_rays = RandRays(500_fx);
+  // Long-range sensors.
+  auto long_rays = RandRays(30000_fx);
+  auto axis_aligned_rays = RandRays(5000_fx);
+  for (size_t i = 0; i < kInputCount; i++) {
+    axis_aligned_rays[i].end_.y_ = axis_aligned_rays[i].start_.y_;
+  }
+
+  runner.Run("Grid/GridPositionFromFVec2", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(GridPositionFromFVec2(positions[i & kInputMask]));
+    }
+  });
+  runner.Run("Grid/Walk/short", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      Ray const& r = short_rays[i & kInputMask];
+      DoNotOptimize(Walk(r.start_, r.end_, kGridSize));
+    }
+  });
+  runner.Run("Grid/Walk/long", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      Ray const& r = long_rays[i & kInputMask];
+      DoNotOptimize(Walk(r.start_, r.end_, kGridSize));
+    }
+  });
+  runner.Run("Grid/Walk/axis_aligned", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      Ray const& r = axis_aligned_rays[i & kInputMask];
+      DoNotOptimize(Walk(r.start_, r.end_, kGridSize));
+    }
+  });
+  // The same rays, visited without allocating.
+  auto visit = [](Ray const& r) {
+    int32_t visited = 0;
+    WalkVisit(r.start_, r.end_, kGridSize, [&visited](GridPosition p) {
+      visited += p.x_;
+      return true;
+    });
+    return visited;
+  };
+  runner.Run("Grid/WalkVisit/short", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(visit(short_rays[i & kInputMask]));
+    }
+  });
+  runner.Run("Grid/WalkVisit/long", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(visit(long_rays[i & kInputMask]));
+    }
+  });
+  runner.Run("Grid/WalkVisit/axis_aligned", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(visit(axis_aligned_rays[i & kInputMask]));
+    }
+  });
+  // The long rays, walked over several calls of at most 256 steps, and with
+  // a range-based for loop.
+  runner.Run("Grid/GridWalker/long/budget:256", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      Ray const& r = long_rays[i & kInputMask];
+      GridWalker walker(r.start_, r.end_, kGridSize);
+      int32_t visited = 0;
+      while (!walker.Resume(256, [&visited](GridPosition p) {
+        visited += p.x_;
+        return true;
+      })) {
+      }
+      DoNotOptimize(visited);
+    }
+  });
+  runner.Run("Grid/GridWalker/long/range", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      Ray const& r = long_rays[i & kInputMask];
+      int32_t visited = 0;
+      for (GridPosition p : GridWalker(r.start_, r.end_, kGridSize)) {
+        visited += p.x_;
+      }
+      DoNotOptimize(visited);
+    }
+  });
+
+  // Projectiles stopping at the first blocked square, with about one square
+  // in 500 blocked, compared to scanning the result of |Walk|.
+  auto is_blocked = [](GridPosition p) {
+    return (p.x_ * 31 + p.y_ * 17) % 500 == 0;
+  };
+  runner.Run("Grid/RaycastFirst/long/Walk", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      Ray const& r = long_rays[i & kInputMask];
+      std::vector<GridPosition> walked = Walk(r.start_, r.end_, kGridSize);
+      DoNotOptimize(std::find_if(walked.begin(), walked.end(), is_blocked) -
+                    walked.begin());
+    }
+  });
+  runner.Run("Grid/RaycastFirst/long", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      Ray const& r = long_rays[i & kInputMask];
+      DoNotOptimize(RaycastFirst(r.start_, r.end_, kGridSize, is_blocked));
+    }
+  });
+
+  // The same rays, walked all at once into a buffer reused between runs.
+  std::vector<FVec2> short_starts;
+  std::vector<FVec2> short_ends;
+  for (Ray const& r : short_rays) {
+    short_starts.push_back(r.start_);
+    short_ends.push_back(r.end_);
+  }
+  runner.Run(
+      "Grid/Walk/short/loop",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          for (size_t j = 0; j < kInputCount; j++) {
+            DoNotOptimize(Walk(short_starts[j], short_ends[j], kGridSize));
+          }
+        }
+      },
+      kInputCount);
+  WalkBuffer walk_buffer;
+  runner.Run(
+      "Grid/WalkMany/short",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          WalkMany(short_starts.data(), short_ends.data(), kInputCount,
+                   kGridSize, walk_buffer);
+          DoNotOptimize(walk_buffer.positions_.data());
+        }
+      },
+      kInputCount);
+  // Scaling with the number of threads, on the long rays.
+  std::vector<FVec2> long_starts;
+  std::vector<FVec2> long_ends;
+  for (Ray const& r : long_rays) {
+    long_starts.push_back(r.start_);
+    long_ends.push_back(r.end_);
+  }
+  for (int thread_count : ThreadCounts()) {
+    ThreadPool pool(thread_count);
+    runner.Run(
+        "Grid/WalkMany/long/threads:" + std::to_string(thread_count),
+        [&](int64_t iterations) {
+          for (int64_t i = 0; i < iterations; i++) {
+            WalkMany(long_starts.data(), long_ends.data(), kInputCount,
+                     kGridSize, walk_buffer, &pool);
+            DoNotOptimize(walk_buffer.positions_.data());
+          }
+        },
+        kInputCount);
+  }
+
+  // The same short rays on grids of squares of size 32, found with shifts,
+  // and of size 48, found with divisions.
+  for (FInt cell_size : {32_fx, 48_fx}) {
+    GridSpec spec(kGridSize, cell_size, FVec2(-1000_fx, -1000_fx));
+    runner.Run("Grid/WalkVisit/short/cell_size:" + cell_size.ToString(),
+               [&](int64_t iterations) {
+                 for (int64_t i = 0; i < iterations; i++) {
+                   Ray const& r = short_rays[i & kInputMask];
+                   int32_t visited = 0;
+                   WalkVisit(r.start_, r.end_, spec,
+                             [&visited](GridPosition p) {
+                               visited += p.x_;
+                               return true;
+                             });
+                   DoNotOptimize(visited);
+                 }
+               });
+  }
+
+  // Line-of-sight checks on a grid where 1% of the squares are blocked, with
+  // |Walk| and with |LineOfSight|.
+  constexpr int32_t kSightGridSize = 1 << 12;
+  LineOfSight sight_grid({kSightGridSize, kSightGridSize});
+  auto blocked = RandFVec2s(kSightGridSize * kSightGridSize / 100, 0_fx,
+                            FInt::FromInt(kSightGridSize - 1));
+  for (FVec2 const& v : blocked) {
+    sight_grid.SetBlocked({v.x_.Int32(), v.y_.Int32()}, true);
+  }
+  FInt sight_center = FInt::FromInt(64 * kSightGridSize / 2);
+  auto viewers =
+      RandFVec2s(kInputCount, sight_center - 1000_fx, sight_center + 1000_fx);
+  auto sight_targets = RandFVec2s(kInputCount, sight_center - 3000_fx,
+                                  sight_center + 3000_fx);
+  runner.Run("Grid/LineOfSight/Walk", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      bool visible = true;
+      for (GridPosition const& p :
+           Walk(viewers[i & kInputMask], sight_targets[i & kInputMask],
+                sight_grid.Size())) {
+        if (sight_grid.IsBlocked(p)) {
+          visible = false;
+          break;
+        }
+      }
+      DoNotOptimize(visible);
+    }
+  });
+  runner.Run("Grid/LineOfSight/IsVisible", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      DoNotOptimize(sight_grid.IsVisible(viewers[i & kInputMask],
+                                         sight_targets[i & kInputMask]));
+    }
+  });
+  std::unique_ptr<bool[]> visible(new bool[kInputCount]);
+  for (int thread_count : ThreadCounts()) {
+    ThreadPool pool(thread_count);
+    runner.Run(
+        "Grid/LineOfSight/VisibleMask/threads:" + std::to_string(thread_count),
+        [&](int64_t iterations) {
+          for (int64_t i = 0; i < iterations; i++) {
+            sight_grid.VisibleMask(viewers[i & kInputMask],
+                                   sight_targets.data(), kInputCount,
+                                   visible.get(), &pool);
+            DoNotOptimize(visible.get());
+          }
+        },
+        kInputCount);
+  }
+}
@@ -0,0 +1,8 @@
+#ifndef DUX_FIXED_BENCH_BENCH_GRID_WALKING_H_
+#define DUX_FIXED_BENCH_BENCH_GRID_WALKING_H_
+
+#include "benchmark.h"
+
+void BenchGridWalking(dux_bench::Runner& runner);
+
+#endif  // DUX_FIXED_BENCH_BENCH_GRID_WALKING_H_
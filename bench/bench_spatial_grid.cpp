@@ -0,0 +1,89 @@
+#include "bench_spatial_grid.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "spatial_grid.h"
+
+using namespace dux;
+using namespace dux_bench;
+
+void BenchSpatialGrid(Runner& runner) {
+  // Units spread over a world of 256x256 squares.
+  constexpr size_t kUnitCount = 1 << 14;
+  constexpr GridSize kWorldSize = {256, 256};
+  auto units = RandFVec2s(kUnitCount, 0_fx, FInt::FromInt(64 * 256));
+  auto centers = RandFVec2s(kInputCount, 0_fx, FInt::FromInt(64 * 256));
+  FInt radius = 150_fx;
+
+  // The buckets rebuilt every tick in a hash map, as done without
+  // |SpatialGrid|.
+  std::unordered_map<int64_t, std::vector<uint32_t>> buckets;
+  auto bucket_key = [](GridPosition p) {
+    return (int64_t(p.y_) << 32) | uint32_t(p.x_);
+  };
+  runner.Run(
+      "Spatial/Build/unordered_map",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          buckets.clear();
+          for (size_t j = 0; j < kUnitCount; j++) {
+            buckets[bucket_key(GridPositionFromFVec2(units[j]))].push_back(
+                static_cast<uint32_t>(j));
+          }
+          DoNotOptimize(buckets.size());
+        }
+      },
+      kUnitCount);
+  runner.Run("Spatial/QueryRadius/unordered_map", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      FVec2 center = centers[i & kInputMask];
+      GridPosition first =
+          GridPositionFromFVec2(center - FVec2(radius, radius));
+      GridPosition last = GridPositionFromFVec2(center + FVec2(radius, radius));
+      uint32_t found = 0;
+      for (int32_t y = first.y_; y <= last.y_; y++) {
+        for (int32_t x = first.x_; x <= last.x_; x++) {
+          auto bucket = buckets.find(bucket_key({x, y}));
+          if (bucket == buckets.end()) {
+            continue;
+          }
+          for (uint32_t id : bucket->second) {
+            found += units[id].SquareLengthFrom(center) <= radius * radius;
+          }
+        }
+      }
+      DoNotOptimize(found);
+    }
+  });
+
+  SpatialGrid grid(kWorldSize);
+  runner.Run(
+      "Spatial/Build",
+      [&](int64_t iterations) {
+        for (int64_t i = 0; i < iterations; i++) {
+          grid.Build(units.data(), units.size());
+          DoNotOptimize(grid.Size());
+        }
+      },
+      kUnitCount);
+  runner.Run("Spatial/QueryRadius", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      uint32_t found = 0;
+      grid.QueryRadius(centers[i & kInputMask], radius,
+                       [&found](uint32_t, FVec2 const&) { found++; });
+      DoNotOptimize(found);
+    }
+  });
+  runner.Run("Spatial/QueryBox", [&](int64_t iterations) {
+    for (int64_t i = 0; i < iterations; i++) {
+      FVec2 center = centers[i & kInputMask];
+      uint32_t found = 0;
+      grid.QueryBox(center - FVec2(radius, radius),
+                    center + FVec2(radius, radius),
+                    [&found](uint32_t, FVec2 const&) { found++; });
+      DoNotOptimize(found);
+    }
+  });
+}
@@ -0,0 +1,8 @@
+#ifndef DUX_FIXED_BENCH_BENCH_SPATIAL_GRID_H_
+#define DUX_FIXED_BENCH_BENCH_SPATIAL_GRID_H_
+
+#include "benchmark.h"
+
+void BenchSpatialGrid(dux_bench::Runner& runner);
+
+#endif  // DUX_FIXED_BENCH_BENCH_SPATIAL_GRID_H_
@@ -0,0 +1,184 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <random>
+#include <thread>
+
+namespace dux_bench {
+
+namespace {
+
+std::linear_congruential_engine<uint32_t, 48271, 0, 2147483647> rng;
+
+dux::FInt RandFInt(dux::FInt min, dux::FInt max) {
+  assert(max >= min);
+  std::uniform_int_distribution<int64_t> uid(min.raw_value_, max.raw_value_);
+  return dux::FInt::FromRawValue(uid(rng));
+}
+
+struct Timing {
+  double real_seconds_;
+  double cpu_seconds_;
+};
+
+Timing TimeIterations(std::function<void(int64_t)> const& body,
+                      int64_t iterations) {
+  std::clock_t cpu_start = std::clock();
+  auto real_start = std::chrono::steady_clock::now();
+  body(iterations);
+  auto real_end = std::chrono::steady_clock::now();
+  std::clock_t cpu_end = std::clock();
+  return {std::chrono::duration<double>(real_end - real_start).count(),
+          static_cast<double>(cpu_end - cpu_start) / CLOCKS_PER_SEC};
+}
+
+}  // namespace
+
+Runner::Runner(std::string filter,
+               double min_time_seconds,
+               std::ostream& console)
+    : filter_(std::move(filter)),
+      min_time_seconds_(min_time_seconds),
+      console_(console) {}
+
+void Runner::Run(std::string const& name,
+                 std::function<void(int64_t iterations)> const& body,
+                 int64_t items_per_iteration,
+                 Counters const& counters) {
+  if (name.find(filter_) == std::string::npos) {
+    return;
+  }
+  // Warm up caches and branch predictors.
+  body(1);
+
+  int64_t iterations = 1;
+  Timing timing = TimeIterations(body, iterations);
+  while (timing.real_seconds_ < min_time_seconds_ && iterations < (1LL << 40)) {
+    // Aim for 1.4x the minimum time, but grow by at most 10x at once.
+    double multiplier = 10;
+    if (timing.real_seconds_ > 0) {
+      multiplier = std::min(
+          10.0, (min_time_seconds_ * 1.4) / timing.real_seconds_);
+    }
+    iterations = std::max(iterations + 1,
+                          static_cast<int64_t>(iterations * multiplier));
+    timing = TimeIterations(body, iterations);
+  }
+
+  int64_t items = iterations * items_per_iteration;
+  Result result;
+  result.name_ = name;
+  result.iterations_ = iterations;
+  result.real_ns_per_op_ = timing.real_seconds_ * 1e9 / items;
+  result.cpu_ns_per_op_ = timing.cpu_seconds_ * 1e9 / items;
+  result.ops_per_second_ =
+      timing.real_seconds_ > 0 ? items / timing.real_seconds_ : 0;
+  result.counters_ = counters;
+  results_.push_back(result);
+  PrintConsoleResult(result);
+}
+
+void Runner::PrintConsoleHeader() const {
+  console_ << std::left << std::setw(44) << "Benchmark" << std::right
+         << std::setw(14) << "Time" << std::setw(14) << "CPU"
+         << std::setw(14) << "Iterations" << std::setw(16) << "ops/s"
+         << "\n";
+  console_ << std::string(102, '-') << "\n";
+}
+
+void Runner::PrintConsoleResult(Result const& result) const {
+  console_ << std::left << std::setw(44) << result.name_ << std::right
+         << std::fixed << std::setprecision(2) << std::setw(11)
+         << result.real_ns_per_op_ << " ns" << std::setw(11)
+         << result.cpu_ns_per_op_ << " ns" << std::setw(14)
+         << result.iterations_ << std::setprecision(0) << std::setw(16)
+         << result.ops_per_second_;
+  for (auto const& [name, value] : result.counters_) {
+    console_ << " " << name << "=" << std::defaultfloat
+             << std::setprecision(4) << value;
+  }
+  console_ << std::endl;
+}
+
+void Runner::PrintJson(std::ostream& stream) const {
+  std::time_t now = std::time(nullptr);
+  char date[64];
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+  stream << "{\n";
+  stream << "  \"context\": {\n";
+  stream << "    \"date\": \"" << date << "\",\n";
+  stream << "    \"num_cpus\": " << std::thread::hardware_concurrency()
+         << ",\n";
+#if defined(DUX_FIXED_HEADER_ONLY)
+  stream << "    \"dux_fixed_header_only\": true,\n";
+#else
+  stream << "    \"dux_fixed_header_only\": false,\n";
+#endif
+#ifdef NDEBUG
+  stream << "    \"library_build_type\": \"release\"\n";
+#else
+  stream << "    \"library_build_type\": \"debug\"\n";
+#endif
+  stream << "  },\n";
+  stream << "  \"benchmarks\": [\n";
+  stream << std::setprecision(6);
+  for (size_t i = 0; i < results_.size(); i++) {
+    Result const& r = results_[i];
+    stream << "    {\n";
+    stream << "      \"name\": \"" << r.name_ << "\",\n";
+    stream << "      \"run_name\": \"" << r.name_ << "\",\n";
+    stream << "      \"run_type\": \"iteration\",\n";
+    stream << "      \"iterations\": " << r.iterations_ << ",\n";
+    stream << "      \"real_time\": " << r.real_ns_per_op_ << ",\n";
+    stream << "      \"cpu_time\": " << r.cpu_ns_per_op_ << ",\n";
+    stream << "      \"time_unit\": \"ns\",\n";
+    stream << "      \"items_per_second\": " << r.ops_per_second_;
+    for (auto const& [name, value] : r.counters_) {
+      stream << ",\n      \"" << name << "\": " << value;
+    }
+    stream << "\n";
+    stream << "    }" << (i + 1 < results_.size() ? "," : "") << "\n";
+  }
+  stream << "  ]\n";
+  stream << "}\n";
+}
+
+std::vector<dux::FInt> RandFInts(size_t count, dux::FInt min, dux::FInt max) {
+  std::vector<dux::FInt> v;
+  v.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    v.push_back(RandFInt(min, max));
+  }
+  return v;
+}
+
+std::vector<dux::FVec2> RandFVec2s(size_t count,
+                                   dux::FInt min,
+                                   dux::FInt max) {
+  std::vector<dux::FVec2> v;
+  v.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    dux::FInt x = RandFInt(min, max);
+    dux::FInt y = RandFInt(min, max);
+    v.emplace_back(x, y);
+  }
+  return v;
+}
+
+std::vector<int> ThreadCounts() {
+  int core_count =
+      std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+  std::vector<int> counts;
+  for (int count = 1; count < core_count; count *= 2) {
+    counts.push_back(count);
+  }
+  counts.push_back(core_count);
+  return counts;
+}
+
+}  // namespace dux_bench
@@ -0,0 +1,96 @@
+#ifndef DUX_FIXED_BENCH_BENCHMARK_H_
+#define DUX_FIXED_BENCH_BENCHMARK_H_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "dux_fixed.h"
+
+namespace dux_bench {
+
+// Prevents the compiler from optimizing away the computation of |value|.
+template <typename T>
+inline void DoNotOptimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+// Extra values reported with the timings, e.g. the accuracy of the measured
+// function, like the user counters of Google Benchmark.
+using Counters = std::map<std::string, double>;
+
+struct Result {
+  std::string name_;
+  int64_t iterations_;
+  double real_ns_per_op_;
+  double cpu_ns_per_op_;
+  double ops_per_second_;
+  Counters counters_;
+};
+
+// Runs benchmarks and collects their timings, in the spirit of Google
+// Benchmark.
+class Runner {
+ public:
+  // Only the benchmarks whose name contains |filter| are run. Each benchmark
+  // runs for at least |min_time_seconds|. Progress is printed to |console|.
+  Runner(std::string filter, double min_time_seconds, std::ostream& console);
+
+  // Times |body|, which must perform the measured operation exactly
+  // |iterations| times. The number of iterations is increased until the
+  // minimum running time is reached.
+  // When one iteration processes several items (e.g. a whole array), the
+  // timings are reported per item.
+  // |counters| are reported along with the timings.
+  void Run(std::string const& name,
+           std::function<void(int64_t iterations)> const& body,
+           int64_t items_per_iteration = 1,
+           Counters const& counters = {});
+
+  // Prints the header of the human readable table.
+  void PrintConsoleHeader() const;
+
+  // Prints all the results in the JSON format of Google Benchmark, so that
+  // its tools (e.g. compare.py) can be used to detect regressions.
+  void PrintJson(std::ostream& stream) const;
+
+  std::vector<Result> const& results() const { return results_; }
+
+ private:
+  void PrintConsoleResult(Result const& result) const;
+
+  std::string filter_;
+  double min_time_seconds_;
+  std::ostream& console_;
+  std::vector<Result> results_;
+};
+
+// Returns |count| numbers uniformly distributed in [min, max]. The sequence is
+// deterministic so that runs can be compared.
+std::vector<dux::FInt> RandFInts(size_t count, dux::FInt min, dux::FInt max);
+
+// Returns |count| vectors uniformly distributed in [min, max]^2.
+std::vector<dux::FVec2> RandFVec2s(size_t count,
+                                   dux::FInt min,
+                                   dux::FInt max);
+
+// Returns the numbers of threads used by the benchmarks of the multithreaded
+// functions: the powers of two below the number of cores, and that number.
+std::vector<int> ThreadCounts();
+
+// Size of the input arrays. A power of two, so that the benchmarks loops can
+// cycle through them with a mask.
+constexpr size_t kInputCount = 1024;
+constexpr size_t kInputMask = kInputCount - 1;
+
+}  // namespace dux_bench
+
+#endif  // DUX_FIXED_BENCH_BENCHMARK_H_
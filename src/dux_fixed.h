@@ -1,9 +1,14 @@
 #ifndef DUX_FIXED_SRC_DUX_FIXED_H_
 #define DUX_FIXED_SRC_DUX_FIXED_H_
 
+#include "fixed_batch.h"
+#include "fixed_divisor.h"
 #include "fixed_int.h"
 #include "fixed_trig.h"
+#include "fixed_trig_table.h"
 #include "fixed_vec2.h"
+#include "fixed_vec2_array.h"
 #include "fixed_vec3.h"
+#include "fixed_vec32.h"
 
 #endif  // DUX_FIXED_SRC_DUX_FIXED_H_
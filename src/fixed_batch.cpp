@@ -0,0 +1,591 @@
+#include "fixed_batch.h"
+
+#include <atomic>
+#include <cassert>
+
+#include "fixed_divisor.h"
+#include "fixed_simd.h"
+
+namespace {
+
+using dux::FInt;
+using dux::batch::Backend;
+using dux::batch::RawType;
+
+using BinaryKernel = void (*)(RawType const*, RawType const*, RawType*, size_t);
+using UnaryKernel = void (*)(RawType const*, RawType*, size_t);
+using MulFIntKernel = void (*)(RawType const*, FInt, RawType*, size_t);
+using MulIntKernel = void (*)(RawType const*, int64_t, RawType*, size_t);
+
+struct Kernels {
+  Backend backend_;
+  BinaryKernel add_;
+  BinaryKernel sub_;
+  BinaryKernel mul_;
+  MulFIntKernel mul_fint_;
+  MulIntKernel mul_int_;
+  UnaryKernel floor_;
+  UnaryKernel ceil_;
+  UnaryKernel round_;
+  UnaryKernel abs_;
+};
+
+// Scalar kernels. They are also used for the values left over by the SIMD
+// kernels.
+
+inline FInt F(RawType raw_value) {
+  return FInt::FromRawValue(raw_value);
+}
+
+void AddScalar(RawType const* a, RawType const* b, RawType* out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = (F(a[i]) + F(b[i])).raw_value_;
+  }
+}
+
+void SubScalar(RawType const* a, RawType const* b, RawType* out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = (F(a[i]) - F(b[i])).raw_value_;
+  }
+}
+
+void MulScalar(RawType const* a, RawType const* b, RawType* out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = (F(a[i]) * F(b[i])).raw_value_;
+  }
+}
+
+void DivScalar(RawType const* a, RawType const* b, RawType* out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = (F(a[i]) / F(b[i])).raw_value_;
+  }
+}
+
+void MulFIntScalar(RawType const* a,
+                   FInt factor,
+                   RawType* out,
+                   size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = (F(a[i]) * factor).raw_value_;
+  }
+}
+
+void MulIntScalar(RawType const* a,
+                  int64_t factor,
+                  RawType* out,
+                  size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = (F(a[i]) * factor).raw_value_;
+  }
+}
+
+void FloorScalar(RawType const* a, RawType* out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = F(a[i]).Floor().raw_value_;
+  }
+}
+
+void CeilScalar(RawType const* a, RawType* out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = F(a[i]).Ceil().raw_value_;
+  }
+}
+
+void RoundScalar(RawType const* a, RawType* out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = F(a[i]).Round().raw_value_;
+  }
+}
+
+void AbsScalar(RawType const* a, RawType* out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = F(a[i]).Abs().raw_value_;
+  }
+}
+
+constexpr Kernels kScalarKernels = {
+    Backend::kScalar, AddScalar,   SubScalar,  MulScalar,
+    MulFIntScalar,    MulIntScalar, FloorScalar, CeilScalar,
+    RoundScalar,      AbsScalar,
+};
+
+#if DUX_FIXED_X86_SIMD
+
+// SSE4.2 kernels.
+//
+// x86 has neither a 64-bit multiplication nor a 64-bit arithmetic shift before
+// AVX-512, so both are built from 32-bit multiplications and logical shifts.
+
+// Returns the low 64 bits of a * b.
+DUX_FIXED_TARGET_SSE42 inline __m128i MulLo64Sse42(__m128i a, __m128i b) {
+  __m128i lo = _mm_mul_epu32(a, b);
+  __m128i cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b),
+                                _mm_mul_epu32(a, _mm_srli_epi64(b, 32)));
+  return _mm_add_epi64(lo, _mm_slli_epi64(cross, 32));
+}
+
+// Returns v / 2^FInt::kShift, rounded toward zero like the C++ division.
+DUX_FIXED_TARGET_SSE42 inline __m128i DivByShiftSse42(__m128i v) {
+  __m128i zero = _mm_setzero_si128();
+  __m128i negative = _mm_cmpgt_epi64(zero, v);
+  v = _mm_add_epi64(
+      v, _mm_and_si128(negative, _mm_set1_epi64x(FInt::kFractionMask)));
+  negative = _mm_cmpgt_epi64(zero, v);
+  return _mm_or_si128(_mm_srli_epi64(v, FInt::kShift),
+                      _mm_slli_epi64(negative, 64 - FInt::kShift));
+}
+
+struct AddSse42 {
+  DUX_FIXED_TARGET_SSE42 __m128i operator()(__m128i a, __m128i b) const {
+    return _mm_add_epi64(a, b);
+  }
+};
+
+struct SubSse42 {
+  DUX_FIXED_TARGET_SSE42 __m128i operator()(__m128i a, __m128i b) const {
+    return _mm_sub_epi64(a, b);
+  }
+};
+
+struct MulSse42 {
+  DUX_FIXED_TARGET_SSE42 __m128i operator()(__m128i a, __m128i b) const {
+    return DivByShiftSse42(MulLo64Sse42(a, b));
+  }
+};
+
+struct FloorSse42 {
+  DUX_FIXED_TARGET_SSE42 __m128i operator()(__m128i a) const {
+    return _mm_and_si128(a, _mm_set1_epi64x(FInt::kIntegerMask));
+  }
+};
+
+struct CeilSse42 {
+  DUX_FIXED_TARGET_SSE42 __m128i operator()(__m128i a) const {
+    __m128i zero = _mm_setzero_si128();
+    __m128i mask = _mm_set1_epi64x(FInt::kIntegerMask);
+    return _mm_sub_epi64(zero, _mm_and_si128(_mm_sub_epi64(zero, a), mask));
+  }
+};
+
+struct RoundSse42 {
+  DUX_FIXED_TARGET_SSE42 __m128i operator()(__m128i a) const {
+    __m128i high_bit = _mm_set1_epi64x(FInt::kHighBitOfFraction);
+    __m128i round_up = _mm_cmpeq_epi64(_mm_and_si128(a, high_bit), high_bit);
+    return _mm_blendv_epi8(FloorSse42()(a), CeilSse42()(a), round_up);
+  }
+};
+
+struct AbsSse42 {
+  DUX_FIXED_TARGET_SSE42 __m128i operator()(__m128i a) const {
+    __m128i negative = _mm_cmpgt_epi64(_mm_setzero_si128(), a);
+    return _mm_sub_epi64(_mm_xor_si128(a, negative), negative);
+  }
+};
+
+template <typename Op>
+DUX_FIXED_TARGET_SSE42 void BinarySse42(RawType const* a,
+                                        RawType const* b,
+                                        RawType* out,
+                                        size_t count,
+                                        BinaryKernel tail) {
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<__m128i const*>(a + i));
+    __m128i vb = _mm_loadu_si128(reinterpret_cast<__m128i const*>(b + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), Op()(va, vb));
+  }
+  tail(a + i, b + i, out + i, count - i);
+}
+
+template <typename Op>
+DUX_FIXED_TARGET_SSE42 void UnarySse42(RawType const* a,
+                                       RawType* out,
+                                       size_t count,
+                                       UnaryKernel tail) {
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<__m128i const*>(a + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), Op()(va));
+  }
+  tail(a + i, out + i, count - i);
+}
+
+void AddSse42Kernel(RawType const* a,
+                    RawType const* b,
+                    RawType* out,
+                    size_t count) {
+  BinarySse42<AddSse42>(a, b, out, count, AddScalar);
+}
+
+void SubSse42Kernel(RawType const* a,
+                    RawType const* b,
+                    RawType* out,
+                    size_t count) {
+  BinarySse42<SubSse42>(a, b, out, count, SubScalar);
+}
+
+void MulSse42Kernel(RawType const* a,
+                    RawType const* b,
+                    RawType* out,
+                    size_t count) {
+  BinarySse42<MulSse42>(a, b, out, count, MulScalar);
+}
+
+DUX_FIXED_TARGET_SSE42 void MulFIntSse42Kernel(RawType const* a,
+                                               FInt factor,
+                                               RawType* out,
+                                               size_t count) {
+  __m128i vfactor = _mm_set1_epi64x(factor.raw_value_);
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<__m128i const*>(a + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     MulSse42()(va, vfactor));
+  }
+  MulFIntScalar(a + i, factor, out + i, count - i);
+}
+
+DUX_FIXED_TARGET_SSE42 void MulIntSse42Kernel(RawType const* a,
+                                              int64_t factor,
+                                              RawType* out,
+                                              size_t count) {
+  __m128i vfactor = _mm_set1_epi64x(factor);
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<__m128i const*>(a + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     MulLo64Sse42(va, vfactor));
+  }
+  MulIntScalar(a + i, factor, out + i, count - i);
+}
+
+void FloorSse42Kernel(RawType const* a, RawType* out, size_t count) {
+  UnarySse42<FloorSse42>(a, out, count, FloorScalar);
+}
+
+void CeilSse42Kernel(RawType const* a, RawType* out, size_t count) {
+  UnarySse42<CeilSse42>(a, out, count, CeilScalar);
+}
+
+void RoundSse42Kernel(RawType const* a, RawType* out, size_t count) {
+  UnarySse42<RoundSse42>(a, out, count, RoundScalar);
+}
+
+void AbsSse42Kernel(RawType const* a, RawType* out, size_t count) {
+  UnarySse42<AbsSse42>(a, out, count, AbsScalar);
+}
+
+constexpr Kernels kSse42Kernels = {
+    Backend::kSse42,    AddSse42Kernel,    SubSse42Kernel,
+    MulSse42Kernel,     MulFIntSse42Kernel, MulIntSse42Kernel,
+    FloorSse42Kernel,   CeilSse42Kernel,   RoundSse42Kernel,
+    AbsSse42Kernel,
+};
+
+// AVX2 kernels. Same algorithms as the SSE4.2 ones, on 4 values at once.
+
+DUX_FIXED_TARGET_AVX2 inline __m256i MulLo64Avx2(__m256i a, __m256i b) {
+  __m256i lo = _mm256_mul_epu32(a, b);
+  __m256i cross =
+      _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                       _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+  return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+}
+
+DUX_FIXED_TARGET_AVX2 inline __m256i DivByShiftAvx2(__m256i v) {
+  __m256i zero = _mm256_setzero_si256();
+  __m256i negative = _mm256_cmpgt_epi64(zero, v);
+  v = _mm256_add_epi64(
+      v, _mm256_and_si256(negative, _mm256_set1_epi64x(FInt::kFractionMask)));
+  negative = _mm256_cmpgt_epi64(zero, v);
+  return _mm256_or_si256(_mm256_srli_epi64(v, FInt::kShift),
+                         _mm256_slli_epi64(negative, 64 - FInt::kShift));
+}
+
+struct AddAvx2 {
+  DUX_FIXED_TARGET_AVX2 __m256i operator()(__m256i a, __m256i b) const {
+    return _mm256_add_epi64(a, b);
+  }
+};
+
+struct SubAvx2 {
+  DUX_FIXED_TARGET_AVX2 __m256i operator()(__m256i a, __m256i b) const {
+    return _mm256_sub_epi64(a, b);
+  }
+};
+
+struct MulAvx2 {
+  DUX_FIXED_TARGET_AVX2 __m256i operator()(__m256i a, __m256i b) const {
+    return DivByShiftAvx2(MulLo64Avx2(a, b));
+  }
+};
+
+struct FloorAvx2 {
+  DUX_FIXED_TARGET_AVX2 __m256i operator()(__m256i a) const {
+    return _mm256_and_si256(a, _mm256_set1_epi64x(FInt::kIntegerMask));
+  }
+};
+
+struct CeilAvx2 {
+  DUX_FIXED_TARGET_AVX2 __m256i operator()(__m256i a) const {
+    __m256i zero = _mm256_setzero_si256();
+    __m256i mask = _mm256_set1_epi64x(FInt::kIntegerMask);
+    return _mm256_sub_epi64(zero,
+                            _mm256_and_si256(_mm256_sub_epi64(zero, a), mask));
+  }
+};
+
+struct RoundAvx2 {
+  DUX_FIXED_TARGET_AVX2 __m256i operator()(__m256i a) const {
+    __m256i high_bit = _mm256_set1_epi64x(FInt::kHighBitOfFraction);
+    __m256i round_up =
+        _mm256_cmpeq_epi64(_mm256_and_si256(a, high_bit), high_bit);
+    return _mm256_blendv_epi8(FloorAvx2()(a), CeilAvx2()(a), round_up);
+  }
+};
+
+struct AbsAvx2 {
+  DUX_FIXED_TARGET_AVX2 __m256i operator()(__m256i a) const {
+    __m256i negative = _mm256_cmpgt_epi64(_mm256_setzero_si256(), a);
+    return _mm256_sub_epi64(_mm256_xor_si256(a, negative), negative);
+  }
+};
+
+template <typename Op>
+DUX_FIXED_TARGET_AVX2 void BinaryAvx2(RawType const* a,
+                                      RawType const* b,
+                                      RawType* out,
+                                      size_t count,
+                                      BinaryKernel tail) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(b + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), Op()(va, vb));
+  }
+  tail(a + i, b + i, out + i, count - i);
+}
+
+template <typename Op>
+DUX_FIXED_TARGET_AVX2 void UnaryAvx2(RawType const* a,
+                                     RawType* out,
+                                     size_t count,
+                                     UnaryKernel tail) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), Op()(va));
+  }
+  tail(a + i, out + i, count - i);
+}
+
+void AddAvx2Kernel(RawType const* a,
+                   RawType const* b,
+                   RawType* out,
+                   size_t count) {
+  BinaryAvx2<AddAvx2>(a, b, out, count, AddScalar);
+}
+
+void SubAvx2Kernel(RawType const* a,
+                   RawType const* b,
+                   RawType* out,
+                   size_t count) {
+  BinaryAvx2<SubAvx2>(a, b, out, count, SubScalar);
+}
+
+void MulAvx2Kernel(RawType const* a,
+                   RawType const* b,
+                   RawType* out,
+                   size_t count) {
+  BinaryAvx2<MulAvx2>(a, b, out, count, MulScalar);
+}
+
+DUX_FIXED_TARGET_AVX2 void MulFIntAvx2Kernel(RawType const* a,
+                                             FInt factor,
+                                             RawType* out,
+                                             size_t count) {
+  __m256i vfactor = _mm256_set1_epi64x(factor.raw_value_);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                        MulAvx2()(va, vfactor));
+  }
+  MulFIntScalar(a + i, factor, out + i, count - i);
+}
+
+DUX_FIXED_TARGET_AVX2 void MulIntAvx2Kernel(RawType const* a,
+                                            int64_t factor,
+                                            RawType* out,
+                                            size_t count) {
+  __m256i vfactor = _mm256_set1_epi64x(factor);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                        MulLo64Avx2(va, vfactor));
+  }
+  MulIntScalar(a + i, factor, out + i, count - i);
+}
+
+void FloorAvx2Kernel(RawType const* a, RawType* out, size_t count) {
+  UnaryAvx2<FloorAvx2>(a, out, count, FloorScalar);
+}
+
+void CeilAvx2Kernel(RawType const* a, RawType* out, size_t count) {
+  UnaryAvx2<CeilAvx2>(a, out, count, CeilScalar);
+}
+
+void RoundAvx2Kernel(RawType const* a, RawType* out, size_t count) {
+  UnaryAvx2<RoundAvx2>(a, out, count, RoundScalar);
+}
+
+void AbsAvx2Kernel(RawType const* a, RawType* out, size_t count) {
+  UnaryAvx2<AbsAvx2>(a, out, count, AbsScalar);
+}
+
+constexpr Kernels kAvx2Kernels = {
+    Backend::kAvx2,   AddAvx2Kernel,    SubAvx2Kernel,   MulAvx2Kernel,
+    MulFIntAvx2Kernel, MulIntAvx2Kernel, FloorAvx2Kernel, CeilAvx2Kernel,
+    RoundAvx2Kernel,  AbsAvx2Kernel,
+};
+
+#endif  // DUX_FIXED_X86_SIMD
+
+Kernels const& KernelsForBackend(Backend backend) {
+  switch (backend) {
+#if DUX_FIXED_X86_SIMD
+    case Backend::kSse42:
+      return kSse42Kernels;
+    case Backend::kAvx2:
+      return kAvx2Kernels;
+#endif
+    default:
+      return kScalarKernels;
+  }
+}
+
+Backend FastestSupportedBackend() {
+  if (dux::batch::IsBackendSupported(Backend::kAvx2)) {
+    return Backend::kAvx2;
+  }
+  if (dux::batch::IsBackendSupported(Backend::kSse42)) {
+    return Backend::kSse42;
+  }
+  return Backend::kScalar;
+}
+
+std::atomic<Kernels const*> active_kernels{nullptr};
+
+Kernels const& ActiveKernels() {
+  Kernels const* kernels = active_kernels.load(std::memory_order_relaxed);
+  if (kernels == nullptr) {
+    kernels = &KernelsForBackend(FastestSupportedBackend());
+    active_kernels.store(kernels, std::memory_order_relaxed);
+  }
+  return *kernels;
+}
+
+}  // namespace
+
+namespace dux::batch {
+
+bool IsBackendSupported(Backend backend) {
+  switch (backend) {
+    case Backend::kScalar:
+      return true;
+#if DUX_FIXED_X86_SIMD
+    case Backend::kSse42:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("sse4.2");
+    case Backend::kAvx2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+#else
+    case Backend::kSse42:
+    case Backend::kAvx2:
+      return false;
+#endif
+  }
+  return false;
+}
+
+Backend ActiveBackend() {
+  return ActiveKernels().backend_;
+}
+
+void SetActiveBackend(Backend backend) {
+  assert(IsBackendSupported(backend));
+  active_kernels.store(&KernelsForBackend(backend), std::memory_order_relaxed);
+}
+
+char const* BackendName(Backend backend) {
+  switch (backend) {
+    case Backend::kScalar:
+      return "scalar";
+    case Backend::kSse42:
+      return "sse4.2";
+    case Backend::kAvx2:
+      return "avx2";
+  }
+  return "unknown";
+}
+
+void Add(RawType const* a, RawType const* b, RawType* out, size_t count) {
+  ActiveKernels().add_(a, b, out, count);
+}
+
+void Sub(RawType const* a, RawType const* b, RawType* out, size_t count) {
+  ActiveKernels().sub_(a, b, out, count);
+}
+
+void Mul(RawType const* a, RawType const* b, RawType* out, size_t count) {
+#if defined(DUX_FIXED_WIDE_ARITHMETIC)
+  // The SIMD kernels compute the products in 64 bits, and would not give the
+  // results of the 128-bit |FInt::operator*|.
+  MulScalar(a, b, out, count);
+#else
+  ActiveKernels().mul_(a, b, out, count);
+#endif
+}
+
+void Div(RawType const* a, RawType const* b, RawType* out, size_t count) {
+  DivScalar(a, b, out, count);
+}
+
+void DivFInt(RawType const* a, FInt divisor, RawType* out, size_t count) {
+  FIntDivisor const fint_divisor(divisor);
+  for (size_t i = 0; i < count; i++) {
+    out[i] = fint_divisor.Divide(F(a[i])).raw_value_;
+  }
+}
+
+void MulFInt(RawType const* a, FInt factor, RawType* out, size_t count) {
+#if defined(DUX_FIXED_WIDE_ARITHMETIC)
+  MulFIntScalar(a, factor, out, count);
+#else
+  ActiveKernels().mul_fint_(a, factor, out, count);
+#endif
+}
+
+void MulInt(RawType const* a, int64_t factor, RawType* out, size_t count) {
+  ActiveKernels().mul_int_(a, factor, out, count);
+}
+
+void Floor(RawType const* a, RawType* out, size_t count) {
+  ActiveKernels().floor_(a, out, count);
+}
+
+void Ceil(RawType const* a, RawType* out, size_t count) {
+  ActiveKernels().ceil_(a, out, count);
+}
+
+void Round(RawType const* a, RawType* out, size_t count) {
+  ActiveKernels().round_(a, out, count);
+}
+
+void Abs(RawType const* a, RawType* out, size_t count) {
+  ActiveKernels().abs_(a, out, count);
+}
+
+}  // namespace dux::batch
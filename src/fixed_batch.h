@@ -0,0 +1,86 @@
+#ifndef DUX_FIXED_SRC_FIXED_BATCH_H_
+#define DUX_FIXED_SRC_FIXED_BATCH_H_
+
+#include <cstddef>
+
+#include "fixed_int.h"
+
+// Functions applying a |FInt| operation to every element of contiguous arrays
+// of raw values.
+//
+// The results are bit-identical to the ones of the corresponding |FInt|
+// operators and methods, whichever backend is used, including when the
+// operations overflow (they wrap around).
+// When DUX_FIXED_WIDE_ARITHMETIC is defined, |Mul| and |MulFInt| always use
+// scalar code.
+// When DUX_FIXED_CHECKED_ARITHMETIC is defined, the overflows are only
+// detected by the scalar code.
+//
+// |out| may be equal to one of the inputs, but must not otherwise overlap
+// with them.
+namespace dux::batch {
+
+using RawType = FInt::RawType;
+
+enum class Backend {
+  // Portable C++.
+  kScalar,
+  // x86-64 SSE4.2 instructions, processing 2 values at once.
+  kSse42,
+  // x86-64 AVX2 instructions, processing 4 values at once.
+  kAvx2,
+};
+
+// Returns whether the CPU running the program supports |backend|.
+bool IsBackendSupported(Backend backend);
+
+// Returns the backend used by the functions below. Defaults to the fastest
+// backend supported by the CPU.
+Backend ActiveBackend();
+
+// Changes the backend used by the functions below.
+// |backend| must be supported.
+void SetActiveBackend(Backend backend);
+
+// Returns the name of |backend|, e.g. "avx2".
+char const* BackendName(Backend backend);
+
+// out[i] = a[i] + b[i]
+void Add(RawType const* a, RawType const* b, RawType* out, size_t count);
+
+// out[i] = a[i] - b[i]
+void Sub(RawType const* a, RawType const* b, RawType* out, size_t count);
+
+// out[i] = a[i] * b[i], as fixed point numbers.
+void Mul(RawType const* a, RawType const* b, RawType* out, size_t count);
+
+// out[i] = a[i] / b[i], as fixed point numbers.
+// There is no SIMD integer division, so all the backends use scalar code.
+void Div(RawType const* a, RawType const* b, RawType* out, size_t count);
+
+// out[i] = a[i] / divisor, as fixed point numbers.
+// Divides with a |FIntDivisor|, which is faster than |Div| once there are a
+// few values.
+void DivFInt(RawType const* a, FInt divisor, RawType* out, size_t count);
+
+// out[i] = a[i] * factor, as fixed point numbers.
+void MulFInt(RawType const* a, FInt factor, RawType* out, size_t count);
+
+// out[i] = a[i] * factor, where |factor| is an integer.
+void MulInt(RawType const* a, int64_t factor, RawType* out, size_t count);
+
+// out[i] = a[i].Floor()
+void Floor(RawType const* a, RawType* out, size_t count);
+
+// out[i] = a[i].Ceil()
+void Ceil(RawType const* a, RawType* out, size_t count);
+
+// out[i] = a[i].Round()
+void Round(RawType const* a, RawType* out, size_t count);
+
+// out[i] = a[i].Abs()
+void Abs(RawType const* a, RawType* out, size_t count);
+
+}  // namespace dux::batch
+
+#endif  // DUX_FIXED_SRC_FIXED_BATCH_H_
@@ -0,0 +1,92 @@
+#ifndef DUX_FIXED_SRC_FIXED_DIVISOR_H_
+#define DUX_FIXED_SRC_FIXED_DIVISOR_H_
+
+#include <cassert>
+#include <cstdint>
+
+#include "fixed_int.h"
+
+namespace dux {
+
+// Division by a |FInt| that is precomputed, for dividing many values by the
+// same divisor (e.g. a tick duration or a cell size): |Divide| replaces the
+// division of |operator/| by a multiplication and shifts.
+//
+// The results are identical to the ones of |operator/|, including when its
+// 64-bit intermediate result wraps around. When DUX_FIXED_WIDE_ARITHMETIC or
+// DUX_FIXED_CHECKED_ARITHMETIC is defined, the dividends whose intermediate
+// result does not fit in 64 bits use |operator/|.
+//
+// Creating a divisor costs about as much as a 128-bit division, so it pays
+// off after a couple of divisions.
+class FIntDivisor {
+ public:
+  // |divisor| must not be 0.
+  constexpr explicit FIntDivisor(FInt divisor)
+      : divisor_(divisor), magic_(0), shift_(0), sign_(0) {
+    assert(divisor.raw_value_ != 0);
+    // The quotient of the magnitudes is computed as
+    // (n * magic_) / 2^(63 + shift_), with magic_ = ceil(2^(63 + shift_) / d)
+    // and 2^shift_ >= d. This is exact for all n <= 2^63, because
+    // magic_ * d - 2^(63 + shift_) < d <= 2^shift_.
+    sign_ = divisor.raw_value_ < 0 ? -1 : 0;
+    uint64_t magnitude = Magnitude(divisor.raw_value_);
+#if defined(__GNUC__)
+    shift_ = magnitude == 1 ? 0 : 64 - __builtin_clzll(magnitude - 1);
+#else
+    while ((uint64_t(1) << shift_) < magnitude) {
+      shift_++;
+    }
+#endif
+    // 2^(63 + shift_) - 1, as a 128-bit number.
+    uint64_t high = shift_ == 0 ? 0 : (uint64_t(1) << (shift_ - 1)) - 1;
+    uint64_t low = shift_ == 0 ? (uint64_t(1) << 63) - 1 : ~uint64_t(0);
+    bool overflow = false;
+    magic_ = DivU128(high, low, magnitude, overflow) + 1;
+    assert(!overflow);
+  }
+
+  constexpr FInt Divisor() const { return divisor_; }
+
+  // Returns |dividend| / |Divisor()|.
+  constexpr FInt Divide(FInt dividend) const {
+#if defined(DUX_FIXED_WIDE_ARITHMETIC) || defined(DUX_FIXED_CHECKED_ARITHMETIC)
+    constexpr int64_t kLimit = int64_t(1) << (63 - FInt::kShift);
+    if (dividend.raw_value_ >= kLimit || dividend.raw_value_ <= -kLimit) {
+      return dividend / divisor_;
+    }
+#endif
+    // Wraps around like the intermediate result of |operator/|.
+    int64_t numerator = static_cast<int64_t>(
+        static_cast<uint64_t>(dividend.raw_value_) << FInt::kShift);
+    uint64_t high = 0;
+    uint64_t low = 0;
+    MulU64(Magnitude(numerator), magic_, high, low);
+    uint64_t quotient = ((high << 1) | (low >> 63)) >> shift_;
+    // Negates the quotient if the signs differ, without branching.
+    uint64_t negate = static_cast<uint64_t>((numerator >> 63) ^ sign_);
+    return FInt::FromRawValue(
+        static_cast<int64_t>((quotient ^ negate) - negate));
+  }
+
+ private:
+  static constexpr uint64_t Magnitude(int64_t value) {
+    uint64_t mask = static_cast<uint64_t>(value >> 63);
+    return (static_cast<uint64_t>(value) ^ mask) - mask;
+  }
+
+  FInt divisor_;
+  uint64_t magic_;
+  int shift_;
+  // -1 if the divisor is negative, 0 otherwise.
+  int64_t sign_;
+};
+
+// Returns |dividend| / |divisor.Divisor()|.
+constexpr FInt operator/(FInt dividend, FIntDivisor const& divisor) {
+  return divisor.Divide(dividend);
+}
+
+}  // namespace dux
+
+#endif  // DUX_FIXED_SRC_FIXED_DIVISOR_H_
@@ -2,222 +2,375 @@
 
 #include <cassert>
 
-namespace dux {
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
-double FInt::DoubleValue() const {
-  double v = static_cast<double>(raw_value_);
-  v /= (1 << kShift);
-  return v;
-}
+namespace dux::internal {
 
-float FInt::FloatValue() const {
-  float v = static_cast<float>(raw_value_);
-  v /= (1 << kShift);
-  return v;
+// Returns the number of leading zero bits of |value|, which must not be 0.
+inline int CountLeadingZeros(uint64_t value) {
+  assert(value != 0);
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return 63 - static_cast<int>(index);
+#else
+  return __builtin_clzll(value);
+#endif
 }
 
-FInt FInt::Sqrt() const {
-  assert(raw_value_ >= 0);
-  if (raw_value_ <= 0) {
-    return FInt(0);
+// Returns 1 / sqrt(x), computed with Newton iterations on doubles at compile
+// time. |x| must be in [0.25, 1].
+constexpr double ConstexprInverseSqrt(double x) {
+  double y = 1.5;
+  for (int i = 0; i < 8; i++) {
+    y = y * (3 - x * y * y) / 2;
   }
+  return y;
+}
 
-  FInt result;
-  // Specialisation for when the value fits in a int32_t.
-  if (raw_value_ < 0x7FFFFFFF) {
-    int32_t value = static_cast<int32_t>(raw_value_);
-    int32_t n = (value >> 1) + 1;
-    int32_t n1 = (n + (value / n)) >> 1;
-    while (n1 < n) {
-      n = n1;
-      n1 = (n + (value / n)) >> 1;
-    }
-    RawType square_root_of_raw_value = n1;
-    result = FInt::FromRawValue(square_root_of_raw_value << kHalfShift);
-  } else {
-    RawType n = (raw_value_ >> 1) + 1;
-    RawType n1 = (n + (raw_value_ / n)) >> 1;
-    while (n1 < n) {
-      n = n1;
-      n1 = (n + (raw_value_ / n)) >> 1;
+// The first approximations of |ScaledInverseSqrt|: 1 / sqrt(m) in Q30, for
+// the mantissas m in [0.25, 1] that are multiples of 2^-kInverseSqrtTableBits.
+// The approximations between them are interpolated linearly.
+constexpr int kInverseSqrtTableBits = 9;
+constexpr int kInverseSqrtTableStart = 1 << (kInverseSqrtTableBits - 2);
+constexpr int kInverseSqrtTableSize =
+    (1 << kInverseSqrtTableBits) - kInverseSqrtTableStart + 1;
+// The number of bits of the mantissa used for the interpolation.
+constexpr int kInverseSqrtFractionBits = 23;
+
+struct InverseSqrtTable {
+  uint32_t values_[kInverseSqrtTableSize] = {};
+
+  constexpr InverseSqrtTable() {
+    for (int i = 0; i < kInverseSqrtTableSize; i++) {
+      double m = static_cast<double>(kInverseSqrtTableStart + i) /
+                 (1 << kInverseSqrtTableBits);
+      values_[i] =
+          static_cast<uint32_t>(ConstexprInverseSqrt(m) * (1 << 30) + 0.5);
     }
-    RawType square_root_of_raw_value = n1;
-    result = FInt::FromRawValue(square_root_of_raw_value << kHalfShift);
   }
-  return result;
-}
+};
 
-FInt FInt::EuclideanDivisionRemainder(dux::FInt upper_bound) const {
-  assert(upper_bound > 0_fx);
-  if (raw_value_ >= 0) {
-    return dux::FInt(raw_value_ % upper_bound.raw_value_);
-  } else {
-    auto raw =
-        (upper_bound.raw_value_ + ((raw_value_ + 1) % upper_bound.raw_value_)) -
-        1;
-    return dux::FInt(raw);
+inline constexpr InverseSqrtTable kInverseSqrtTable;
+
+// Returns 2^x, computed with its Taylor series on doubles at compile time.
+// |x| must be in [0, 1].
+constexpr double ConstexprExp2(double x) {
+  double y = x * 0.69314718055994530942;
+  double term = 1;
+  double sum = 1;
+  for (int i = 1; i < 25; i++) {
+    term *= y / i;
+    sum += term;
   }
+  return sum;
 }
 
-[[nodiscard]] FInt Pow(FInt const x, FInt const y) {
-  if (y.raw_value_ == 0) {
-    return 1_fx;  // x^0 = 1
-  }
-  if (x.raw_value_ == 0) {
-    return 0_fx;  // 0^y = 0  if y!=0
+// Returns ln(x), computed with the series of atanh on doubles at compile
+// time. |x| must be in [0.5, 1].
+constexpr double ConstexprLn(double x) {
+  double z = (x - 1) / (x + 1);
+  double term = z;
+  double sum = 0;
+  for (int i = 1; i < 60; i += 2) {
+    sum += term / i;
+    term *= z * z;
   }
+  return 2 * sum;
+}
+
+constexpr int64_t kOneQ32 = int64_t(1) << 32;
+// ln(2) in Q32 and Q40, and log2(e) in Q62.
+constexpr int64_t kLn2Q32 = 2977044472;
+constexpr int64_t kLn2Q40 = 762123384786;
+constexpr int64_t kLog2eQ62 = 6653256548922161246;
+
+// The table of |FastLnQ32| splits [1, 2[ in 128 intervals.
+constexpr int kLnTableBits = 7;
+constexpr int kLnTableSize = 1 << kLnTableBits;
+
+struct LnTable {
+  // 1 / c in Q32, with c the middle of [1 + i / 128, 1 + (i + 1) / 128[.
+  uint64_t reciprocals_[kLnTableSize] = {};
+  // -ln(reciprocals_[i] / 2^32) in Q32.
+  int64_t logarithms_[kLnTableSize] = {};
 
-  bool y_is_negative = y < 0_fx;
-  FInt const positive_y = y_is_negative ? -y : y;
-  int32_t fractional_y = positive_y.raw_value_ & dux::FInt::kFractionMask;
-  int64_t integral_y = positive_y.raw_value_ & dux::FInt::kIntegerMask;
-  dux::FInt result = 1_fx;
-  dux::FInt squared = x;
-  if (integral_y) {
-    while (integral_y > dux::FInt::kFractionMask) {
-      if ((integral_y & (1 << dux::FInt::kShift)) != 0) {
-        result *= squared;
-      }
-      squared = (squared * squared);
-      integral_y >>= 1;
+  constexpr LnTable() {
+    for (int i = 0; i < kLnTableSize; i++) {
+      uint64_t denominator = 2 * kLnTableSize + 2 * i + 1;
+      uint64_t numerator = uint64_t(1) << (33 + kLnTableBits);
+      reciprocals_[i] = (numerator + denominator / 2) / denominator;
+      double reciprocal = static_cast<double>(reciprocals_[i]) / kOneQ32;
+      logarithms_[i] =
+          static_cast<int64_t>(-ConstexprLn(reciprocal) * kOneQ32 + 0.5);
     }
   }
-  auto square_rooted = x;
-  while (fractional_y != 0) {
-    square_rooted = square_rooted.Sqrt();
-    if (square_rooted == 1_fx) {
-      break;
-    }
-    if (fractional_y & dux::FInt::kHighBitOfFraction) {
-      result *= square_rooted;
+};
+
+// The table of |FastExp2Q32| splits [0, 1[ in 256 intervals.
+constexpr int kExp2TableBits = 8;
+constexpr int kExp2TableSize = 1 << kExp2TableBits;
+
+struct Exp2Table {
+  // 2^(i / 256) in Q62.
+  uint64_t values_[kExp2TableSize] = {};
+
+  constexpr Exp2Table() {
+    for (int i = 0; i < kExp2TableSize; i++) {
+      values_[i] = static_cast<uint64_t>(
+          ConstexprExp2(static_cast<double>(i) / kExp2TableSize) *
+          static_cast<double>(uint64_t(1) << 62));
     }
-    fractional_y <<= 1;
-    fractional_y &= dux::FInt::kFractionMask;
-  }
-  if (y_is_negative) {
-    return 1_fx / result;
   }
-  return result;
-}
+};
 
-// Fixed-point constants for Exp().
-// ln(2) in Q51.12 format is 0.693147 * 4096 ~= 2839
-static constexpr FInt kLn2 = FInt::FromRawValue(2839LL);
-// 1/ln(2) in Q51.12 format is 1.442695 * 4096 ~= 5909
-static constexpr FInt kInvLn2 = FInt::FromRawValue(5909LL);
+inline constexpr LnTable kLnTable;
+inline constexpr Exp2Table kExp2Table;
 
-[[nodiscard]] FInt Exp(FInt x) {
-  if (x == 0_fx) {
-    return 1_fx;
-  }
+// Returns ln(value / 2^frac_bits) in Q32, with an error below 2^-31.
+// The polynomials are evaluated in a way that shortens the chains of
+// dependent multiplications.
+// |value| must not be 0.
+DUX_FIXED_INLINE int64_t FastLnQ32(uint64_t value, int frac_bits) {
+  int width = dux::BitWidth(value);
+  // value = m * 2^(width - 1), with the mantissa m in [1, 2[ in Q31.
+  uint64_t m = width <= 32 ? value << (32 - width) : value >> (width - 32);
+  int index =
+      static_cast<int>(m >> (31 - kLnTableBits)) & (kLnTableSize - 1);
+  // m * reciprocal = 1 + v, with |v| < 1/255. Q63 -> Q32.
+  int64_t v = static_cast<int64_t>(m * kLnTable.reciprocals_[index] -
+                                   (uint64_t(1) << 63)) >>
+              31;
+  // ln(1 + v) = v - v^2 * (1/2 - v/3), with an error below 2^-34.
+  int64_t v_squared = (v * v) >> 32;
+  int64_t v_third = (v * (kOneQ32 / 3)) >> 32;
+  int64_t ln = v - ((v_squared * (kOneQ32 / 2 - v_third)) >> 32);
+  int64_t exponent = width - 1 - frac_bits;
+  return ((exponent * kLn2Q40) >> 8) + kLnTable.logarithms_[index] + ln;
+}
 
-  // Clamp input to prevent overflow. The largest value for FInt is ~2^51.
-  // ln(2^51) = 51 * ln(2) ~= 35.3. We clamp around this value.
-  if (x > 35_fx) {
-    return FIntMax;
+// Returns 2^(t / 2^32) * 2^frac_bits, rounded to the nearest integer and
+// saturated to |max|. The relative error is below 2^-31.
+DUX_FIXED_INLINE uint64_t FastExp2Q32(int64_t t,
+                                      int frac_bits,
+                                      uint64_t max) {
+  // 2^t = 2^k * 2^(index / 256) * 2^r, with r in [0, 1/256[ in Q32.
+  int64_t k = t >> 32;
+  uint64_t fraction = static_cast<uint64_t>(t) & (kOneQ32 - 1);
+  int index = static_cast<int>(fraction >> (32 - kExp2TableBits));
+  uint64_t r = fraction & ((uint64_t(1) << (32 - kExp2TableBits)) - 1);
+  // 2^r - 1 = r * ln(2) + r^2 * (ln(2)^2 / 2 + r * ln(2)^3 / 6), with an
+  // error below 2^-38.
+  constexpr uint64_t kC2 = 1031764991;
+  constexpr uint64_t kC3 = 238388332;
+  uint64_t r_squared = (r * r) >> 32;
+  uint64_t p = ((r * kLn2Q32) >> 32) +
+               ((r_squared * (kC2 + ((r * kC3) >> 32))) >> 32);
+  // The mantissa 2^(index / 256) * 2^r in Q62, in [2^62, 2^63].
+  uint64_t base = kExp2Table.values_[index];
+  uint64_t mantissa = base + (base >> 32) * p;
+  int64_t shift = 62 - frac_bits - k;
+  if (shift >= 64) {
+    return 0;
   }
-  // For large negative x, e^x underflows to 0.
-  if (x < -35_fx) {
-    return 0_fx;
+  if (shift < 0) {
+    return max;
   }
+  uint64_t result =
+      shift == 0 ? mantissa
+                 : (mantissa + (uint64_t(1) << (shift - 1))) >> shift;
+  return result < max ? result : max;
+}
 
-  // Range reduction: e^x = 2^k * e^(x'), where x' = x - k*ln(2) and |x'| <=
-  // ln(2)/2. First, find k = round(x / ln(2)) = round(x * (1/ln(2))).
-  FInt k_fint = x * kInvLn2;
-  int32_t k = k_fint.Round().Int32();
+// e^kExpLimit overflows all the fixed point numbers, and e^-kExpLimit
+// rounds to 0 in all of them.
+constexpr int kExpLimit = 44;
 
-  // Then, find x' = x - k * ln(2).
-  FInt x_prime = x - (FInt::FromInt(k) * kLn2);
+}  // namespace dux::internal
 
-  // Calculate e^(x') using Taylor series: 1 + x' + (x')^2/2! + (x')^3/3! ...
-  FInt sum = 1_fx + x_prime;
-  FInt term = x_prime;
+namespace dux {
 
-  // With range reduction, the series converges quickly. 10-12 terms are ample.
-  for (int i = 2; i < 12; ++i) {
-    term = (term * x_prime) / i;
-    // Once the term is too small to contribute, we can stop.
-    if (term.raw_value_ == 0) {
-      break;
-    }
-    sum += term;
+DUX_FIXED_INLINE uint64_t ScaledInverseSqrt(uint64_t value) {
+  assert(value != 0);
+  // value = m / 2^z, with the mantissa m in [2^62, 2^64[ and z even, so that
+  // 1 / sqrt(value) = 2^(z / 2) / sqrt(m).
+  int z = internal::CountLeadingZeros(value) & ~1;
+  uint64_t m = value << z;
+  // y approximates 2^30 / sqrt(m / 2^64), which is in ]2^30, 2^31]. The linear
+  // interpolation has a relative error below 2^-17.
+  size_t index = (m >> (64 - internal::kInverseSqrtTableBits)) -
+                 internal::kInverseSqrtTableStart;
+  uint64_t fraction =
+      (m >> (64 - internal::kInverseSqrtTableBits -
+             internal::kInverseSqrtFractionBits)) &
+      ((uint64_t(1) << internal::kInverseSqrtFractionBits) - 1);
+  uint64_t y = internal::kInverseSqrtTable.values_[index];
+  uint64_t step = y - internal::kInverseSqrtTable.values_[index + 1];
+  y -= (step * fraction) >> internal::kInverseSqrtFractionBits;
+  // A Newton iteration y = y * (3 - m * y^2) / 2 squares the relative error.
+  // Q30 * Q30 -> Q30, then Q32 * Q30 -> Q62.
+  uint64_t m_y_squared = (m >> 32) * ((y * y) >> 30);
+  uint64_t three_minus = (uint64_t(3) << 62) - m_y_squared;
+  // Q30 * Q31 -> Q30, including the division by 2.
+  y = (y * (three_minus >> 31)) >> 32;
+  return y << (z / 2);
+}
+
+template <typename RawT, int kFracBits>
+double Fixed<RawT, kFracBits>::DoubleValue() const {
+  double v = static_cast<double>(raw_value_);
+  v /= static_cast<double>(kOne);
+  return v;
+}
+
+template <typename RawT, int kFracBits>
+float Fixed<RawT, kFracBits>::FloatValue() const {
+  float v = static_cast<float>(raw_value_);
+  v /= static_cast<float>(kOne);
+  return v;
+}
+
+template <typename RawT, int kFracBits>
+Fixed<RawT, kFracBits> Fixed<RawT, kFracBits>::InvSqrt() const {
+  static_assert(kShift % 2 == 0,
+                "The inverse square root needs an even kShift.");
+  assert(raw_value_ > 0);
+  // 1 / sqrt(raw_value_ / 2^kShift) * 2^kShift = 2^(kShift * 3 / 2) /
+  // sqrt(raw_value_).
+  constexpr int kResultShift = 62 - kShift - kHalfShift;
+  uint64_t scaled = ScaledInverseSqrt(static_cast<uint64_t>(raw_value_));
+  return Fixed::FromRawValue(static_cast<RawType>(
+      (scaled + (uint64_t(1) << (kResultShift - 1))) >> kResultShift));
+}
+
+template <typename RawT, int kFracBits>
+Fixed<RawT, kFracBits> Fixed<RawT, kFracBits>::EuclideanDivisionRemainder(
+    Fixed upper_bound) const {
+  assert(upper_bound > Fixed());
+  if (raw_value_ >= 0) {
+    return Fixed(raw_value_ % upper_bound.raw_value_);
+  } else {
+    auto raw =
+        (upper_bound.raw_value_ + ((raw_value_ + 1) % upper_bound.raw_value_)) -
+        1;
+    return Fixed(raw);
   }
+}
 
-  // Final result is sum * 2^k. This is a bit shift on the raw value.
-  if (k > 0) {
-    // Prevent overflow from the shift. A left shift by ~50 is the max.
-    if (k >= 50) {
-      return FIntMax;
-    }
-    return FInt::FromRawValue(sum.raw_value_ << k);
+template <typename RawT, int kFracBits>
+[[nodiscard]] Fixed<RawT, kFracBits> FastExp(Fixed<RawT, kFracBits> x) {
+  using F = Fixed<RawT, kFracBits>;
+  static_assert(F::kShift <= 24);
+  constexpr uint64_t kMax = std::numeric_limits<RawT>::max();
+  constexpr int64_t kLimit = int64_t(internal::kExpLimit) << F::kShift;
+  if (x.raw_value_ >= kLimit) {
+    return F::FromRawValue(static_cast<RawT>(kMax));
   }
-  if (k < 0) {
-    int rshift = -k;
-    // Prevent shifting by more than the bit width.
-    if (rshift >= 64) {
-      return 0_fx;
-    }
-    return FInt::FromRawValue(sum.raw_value_ >> rshift);
+  if (x.raw_value_ <= -kLimit) {
+    return F();
   }
-  // if k == 0
-  return sum;
+  // x * log2(e) in Q32. log2(e) has as many bits as the product allows.
+  constexpr int kLog2eShift = 56 - F::kShift;
+  constexpr int64_t kLog2e =
+      ((internal::kLog2eQ62 >> (61 - kLog2eShift)) + 1) >> 1;
+  int64_t t = (static_cast<int64_t>(x.raw_value_) * kLog2e) >>
+              (kLog2eShift + F::kShift - 32);
+  return F::FromRawValue(
+      static_cast<RawT>(internal::FastExp2Q32(t, F::kShift, kMax)));
 }
 
-[[nodiscard]] FInt Ln(FInt x) {
-  assert(x > 0_fx && "Logarithm argument must be positive");
-  if (x <= 0_fx) {
-    return FIntMin;  // Return error value
+template <typename RawT, int kFracBits>
+[[nodiscard]] Fixed<RawT, kFracBits> FastLn(Fixed<RawT, kFracBits> x) {
+  using F = Fixed<RawT, kFracBits>;
+  static_assert(F::kShift <= 24);
+  assert(x > F() && "Logarithm argument must be positive");
+  if (x <= F()) {
+    return F::FromRawValue(std::numeric_limits<RawT>::min());
   }
+  int64_t ln =
+      internal::FastLnQ32(static_cast<uint64_t>(x.raw_value_), F::kShift);
+  constexpr int kRoundingShift = 32 - F::kShift;
+  return F::FromRawValue(static_cast<RawT>(
+      (ln + (int64_t(1) << (kRoundingShift - 1))) >> kRoundingShift));
+}
 
-  // 1) Extract integer power of 2: x = y * 2^k, with y in [1,2).
-  int32_t k = 0;
-  FInt y = x;
-  // bring y into [1,2)
-  while (y > 2_fx) {
-    y.raw_value_ >>= 1;
-    ++k;
+template <typename RawT, int kFracBits>
+[[nodiscard]] Fixed<RawT, kFracBits> FastPow(Fixed<RawT, kFracBits> x,
+                                             Fixed<RawT, kFracBits> y) {
+  using F = Fixed<RawT, kFracBits>;
+  static_assert(F::kShift <= 24);
+  constexpr uint64_t kMax = std::numeric_limits<RawT>::max();
+  if (y.raw_value_ == 0) {
+    return F::FromInt(1);  // x^0 = 1
   }
-  while (y < 1_fx) {
-    y.raw_value_ <<= 1;
-    --k;
+  if (x.raw_value_ == 0) {
+    return F();  // 0^y = 0  if y!=0
   }
-
-  // 2) Compute ln(y) via the atanh-series:
-  //    z = (y - 1) / (y + 1)
-  //    ln(y) = 2 * ( z + z^3/3 + z^5/5 + … )
-  FInt z = (y - 1_fx) / (y + 1_fx);
-  FInt z2 = z * z;
-  FInt term = z;
-  FInt sum = term;
-  // sum odd terms
-  for (int n = 3; n <= 11; n += 2) {
-    term = term * z2;
-    sum += (term / FInt::FromInt(n));
+  // (-x)^y = x^y if y is even, -(x^y) if y is odd.
+  bool negative_x = x.raw_value_ < 0;
+  assert((!negative_x || (y.raw_value_ & F::kFractionMask) == 0) &&
+         "A negative number has no real non-integer power");
+  bool negative_result =
+      negative_x && ((y.raw_value_ >> F::kShift) & 1) != 0;
+  uint64_t magnitude =
+      negative_x ? 0 - static_cast<uint64_t>(x.raw_value_)
+                 : static_cast<uint64_t>(x.raw_value_);
+  // y * ln(x) in Q32, clamped to where e^(y * ln(x)) saturates.
+  int64_t ln = internal::FastLnQ32(magnitude, F::kShift);
+  bool success = true;
+  int64_t exponent = MulShiftWide(static_cast<int64_t>(y.raw_value_), ln,
+                                  F::kShift, success);
+  constexpr int64_t kLimit = int64_t(internal::kExpLimit) << 32;
+  if (!success || exponent > kLimit || exponent < -kLimit) {
+    exponent = (y.raw_value_ > 0) == (ln > 0) ? kLimit : -kLimit;
   }
-  FInt ln_y = sum * 2_fx;
-
-  // 3) Reassemble: ln(x) = k*ln(2) + ln(y)
-  return FInt::FromInt(k) * kLn2 + ln_y;
+  int64_t t = MulShiftWide(exponent, internal::kLog2eQ62, 62);
+  RawT result = static_cast<RawT>(internal::FastExp2Q32(t, F::kShift, kMax));
+  return F::FromRawValue(negative_result ? -result : result);
 }
 
-[[nodiscard]] std::string FInt::ToString() const {
+template <typename RawT, int kFracBits>
+[[nodiscard]] std::string Fixed<RawT, kFracBits>::ToString() const {
   return (Int64() == 0 && raw_value_ < 0 ? "-" : "") + std::to_string(Int64()) +
          "." + std::to_string(Frac().raw_value_);
 }
 
-FInt InterpolateAngle(FInt angle_start, FInt angle_end, FInt percentage) {
-  FInt d_angle = angle_end - angle_start;
-  if (d_angle >= -FIntPi && d_angle <= FIntPi) {
-    return angle_start + d_angle * percentage;
-  }
-  d_angle = (angle_end - angle_start) % FIntTau;
-  FInt short_angle = ((2_fx * d_angle) % FIntTau) - d_angle;
-  return angle_start + short_angle * percentage;
-}
+// With DUX_FIXED_HEADER_ONLY, the templates are instantiated where they are
+// used.
+#if !defined(DUX_FIXED_HEADER_ONLY)
+
+#define DUX_FIXED_INSTANTIATE(RawT, kFracBits)                              \
+  template class Fixed<RawT, kFracBits>;                                   \
+  template Fixed<RawT, kFracBits> FastExp(Fixed<RawT, kFracBits>);         \
+  template Fixed<RawT, kFracBits> FastLn(Fixed<RawT, kFracBits>);          \
+  template Fixed<RawT, kFracBits> FastPow(Fixed<RawT, kFracBits>,          \
+                                          Fixed<RawT, kFracBits>)
+
+DUX_FIXED_INSTANTIATE(int64_t, 12);
+DUX_FIXED_INSTANTIATE(int64_t, 16);
+DUX_FIXED_INSTANTIATE(int64_t, 20);
+DUX_FIXED_INSTANTIATE(int32_t, 12);
+DUX_FIXED_INSTANTIATE(int32_t, 16);
+
+#undef DUX_FIXED_INSTANTIATE
+
+#endif  // !defined(DUX_FIXED_HEADER_ONLY)
 
 }  // namespace dux
 
-std::ostream& operator<<(std::ostream& stream, const dux::FInt& fint) {
-  stream << fint.raw_value_ << "(" << fint.DoubleValue() << ")";
+template <typename RawT, int kFracBits>
+std::ostream& operator<<(std::ostream& stream,
+                         const dux::Fixed<RawT, kFracBits>& fixed) {
+  stream << fixed.raw_value_ << "(" << fixed.DoubleValue() << ")";
   return stream;
 }
+
+#if !defined(DUX_FIXED_HEADER_ONLY)
+template std::ostream& operator<<(std::ostream&, const dux::Fixed<int64_t, 12>&);
+template std::ostream& operator<<(std::ostream&, const dux::Fixed<int64_t, 16>&);
+template std::ostream& operator<<(std::ostream&, const dux::Fixed<int64_t, 20>&);
+template std::ostream& operator<<(std::ostream&, const dux::Fixed<int32_t, 12>&);
+template std::ostream& operator<<(std::ostream&, const dux::Fixed<int32_t, 16>&);
+#endif  // !defined(DUX_FIXED_HEADER_ONLY)
@@ -2,73 +2,339 @@
 #define DUX_FIXED_SRC_FIXED_INT_H_
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
+#include <optional>
 #include <sstream>
 #include <type_traits>
 
+// When DUX_FIXED_HEADER_ONLY is defined, the headers include the definitions
+// of the .cpp files, so that all the functions of the library can be inlined
+// without link time optimization. DUX_FIXED_INLINE marks these definitions.
+// The SIMD kernels of fixed_batch.cpp, which are called through function
+// pointers, are compiled in the library in both modes.
+#if defined(DUX_FIXED_HEADER_ONLY)
+#define DUX_FIXED_INLINE inline
+#else
+#define DUX_FIXED_INLINE
+#endif
+
 namespace dux {
 
-// Class encapsulating Q51.12 fixed point numbers.
-class FInt {
+// Type of the intermediate results of the multiplications and divisions of
+// |Fixed| numbers stored in |RawT|.
+// 32-bit numbers are multiplied and divided in 64 bits, so that they only
+// overflow when the result does not fit. 64-bit numbers are multiplied and
+// divided in 64 bits, and overflow when the intermediate result does not fit,
+// unless DUX_FIXED_WIDE_ARITHMETIC is defined (see |Fixed::MulWide|).
+template <typename RawT>
+struct WideRawType;
+template <>
+struct WideRawType<int32_t> {
+  using Type = int64_t;
+};
+template <>
+struct WideRawType<int64_t> {
+  using Type = int64_t;
+};
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef __int128 Int128;
+#endif
+
+// Stores a + b in |result|, and returns whether the addition overflowed, in
+// which case |result| is the wrapped around value.
+template <typename T>
+constexpr bool AddOverflow(T a, T b, T& result) {
+#if defined(__GNUC__)
+  return __builtin_add_overflow(a, b, &result);
+#else
+  using U = std::make_unsigned_t<T>;
+  result = static_cast<T>(static_cast<U>(a) + static_cast<U>(b));
+  return (a >= 0) == (b >= 0) && (result >= 0) != (a >= 0);
+#endif
+}
+
+// Stores a - b in |result|, and returns whether the subtraction overflowed, in
+// which case |result| is the wrapped around value.
+template <typename T>
+constexpr bool SubOverflow(T a, T b, T& result) {
+#if defined(__GNUC__)
+  return __builtin_sub_overflow(a, b, &result);
+#else
+  using U = std::make_unsigned_t<T>;
+  result = static_cast<T>(static_cast<U>(a) - static_cast<U>(b));
+  return (a >= 0) != (b >= 0) && (result >= 0) != (a >= 0);
+#endif
+}
+
+// Stores a * b in |result|, and returns whether the multiplication overflowed,
+// in which case |result| is the wrapped around value.
+template <typename T>
+constexpr bool MulOverflow(T a, T b, T& result) {
+#if defined(__GNUC__)
+  return __builtin_mul_overflow(a, b, &result);
+#else
+  using U = std::make_unsigned_t<T>;
+  result = static_cast<T>(static_cast<U>(a) * static_cast<U>(b));
+  if (a == 0) {
+    return false;
+  }
+  if (a == -1) {
+    return b == std::numeric_limits<T>::min();
+  }
+  return result / a != b;
+#endif
+}
+
+// Returns the number of bits needed to represent |value|: 0 for 0, 64 if its
+// highest bit is set.
+constexpr int BitWidth(uint64_t value) {
+#if defined(__GNUC__)
+  return value == 0 ? 0 : 64 - __builtin_clzll(value);
+#else
+  int width = 0;
+  for (int step = 32; step > 0; step /= 2) {
+    if ((value >> step) != 0) {
+      value >>= step;
+      width += step;
+    }
+  }
+  return width + static_cast<int>(value);
+#endif
+}
+
+// Stores the 128-bit product a * b in |high| and |low|.
+constexpr void MulU64(uint64_t a, uint64_t b, uint64_t& high, uint64_t& low) {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 UInt128;
+  UInt128 product = static_cast<UInt128>(a) * b;
+  high = static_cast<uint64_t>(product >> 64);
+  low = static_cast<uint64_t>(product);
+#else
+  // 4 products of 32-bit halves.
+  uint64_t a_low = a & 0xFFFFFFFF;
+  uint64_t a_high = a >> 32;
+  uint64_t b_low = b & 0xFFFFFFFF;
+  uint64_t b_high = b >> 32;
+  uint64_t low_low = a_low * b_low;
+  uint64_t low_high = a_low * b_high;
+  uint64_t high_low = a_high * b_low;
+  uint64_t middle = (low_low >> 32) + (low_high & 0xFFFFFFFF) +
+                    (high_low & 0xFFFFFFFF);
+  low = (middle << 32) | (low_low & 0xFFFFFFFF);
+  high = a_high * b_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+#endif
+}
+
+// Returns (high * 2^64 + low) / divisor, rounded down. |overflow| is set to
+// true if the quotient does not fit in 64 bits, in which case its low 64 bits
+// are returned.
+// |divisor| must be in [1, 2^63].
+constexpr uint64_t DivU128(uint64_t high,
+                           uint64_t low,
+                           uint64_t divisor,
+                           bool& overflow) {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 UInt128;
+  UInt128 quotient = ((static_cast<UInt128>(high) << 64) | low) / divisor;
+  overflow = (quotient >> 64) != 0;
+  return static_cast<uint64_t>(quotient);
+#else
+  // Long division, one bit at a time. The remainder is less than |divisor| <=
+  // 2^63, so shifting it left never overflows.
+  uint64_t quotient = 0;
+  uint64_t remainder = 0;
+  overflow = false;
+  for (int bit = 127; bit >= 0; bit--) {
+    uint64_t dividend_bit =
+        bit >= 64 ? (high >> (bit - 64)) & 1 : (low >> bit) & 1;
+    remainder = (remainder << 1) | dividend_bit;
+    overflow = overflow || (quotient >> 63) != 0;
+    quotient <<= 1;
+    if (remainder >= divisor) {
+      remainder -= divisor;
+      quotient |= 1;
+    }
+  }
+  return quotient;
+#endif
+}
+
+// Returns (a * b) / 2^shift, rounded toward zero.
+// The product is computed in 128 bits. |success| is set to false if the
+// result does not fit in 64 bits, in which case it is wrapped around.
+// |shift| must be in [1, 63].
+constexpr int64_t MulShiftWide(int64_t a, int64_t b, int shift, bool& success) {
+#if defined(__SIZEOF_INT128__)
+  Int128 product = static_cast<Int128>(a) * b;
+  Int128 result = product / (static_cast<Int128>(1) << shift);
+  success = result >= std::numeric_limits<int64_t>::min() &&
+            result <= std::numeric_limits<int64_t>::max();
+  return static_cast<int64_t>(result);
+#else
+  bool negative = (a < 0) != (b < 0);
+  uint64_t ua = a < 0 ? 0 - static_cast<uint64_t>(a) : a;
+  uint64_t ub = b < 0 ? 0 - static_cast<uint64_t>(b) : b;
+  uint64_t high = 0;
+  uint64_t low = 0;
+  MulU64(ua, ub, high, low);
+  uint64_t result = (low >> shift) | (high << (64 - shift));
+  uint64_t const max_magnitude = uint64_t(1) << 63;
+  success = (high >> shift) == 0 &&
+            (result < max_magnitude || (negative && result == max_magnitude));
+  return static_cast<int64_t>(negative ? 0 - result : result);
+#endif
+}
+
+// Returns (a * b) / 2^shift, rounded toward zero.
+// The product is computed in 128 bits, so the result is only wrong if it does
+// not fit in 64 bits.
+// |shift| must be in [1, 63].
+constexpr int64_t MulShiftWide(int64_t a, int64_t b, int shift) {
+  bool success = true;
+  return MulShiftWide(a, b, shift, success);
+}
+
+// Returns (a * 2^shift) / b, rounded toward zero.
+// The dividend is computed in 128 bits. |success| is set to false if the
+// result does not fit in 64 bits, in which case it is wrapped around.
+// |shift| must be in [1, 63], and |b| must not be 0.
+constexpr int64_t ShiftDivWide(int64_t a, int64_t b, int shift, bool& success) {
+  // 128-bit divisions are several times slower than 64-bit ones, so they are
+  // only used when the dividend does not fit in 64 bits.
+  int64_t const limit = int64_t(1) << (63 - shift);
+  if (a < limit && a > -limit) {
+    success = true;
+    return (a * (int64_t(1) << shift)) / b;
+  }
+#if defined(__SIZEOF_INT128__)
+  Int128 dividend = static_cast<Int128>(a) * (static_cast<Int128>(1) << shift);
+  Int128 result = dividend / b;
+  success = result >= std::numeric_limits<int64_t>::min() &&
+            result <= std::numeric_limits<int64_t>::max();
+  return static_cast<int64_t>(result);
+#else
+  bool negative = (a < 0) != (b < 0);
+  uint64_t ua = a < 0 ? 0 - static_cast<uint64_t>(a) : a;
+  uint64_t ub = b < 0 ? 0 - static_cast<uint64_t>(b) : b;
+  bool overflow = false;
+  uint64_t result = DivU128(ua >> (64 - shift), ua << shift, ub, overflow);
+  uint64_t const max_magnitude = uint64_t(1) << 63;
+  success = !overflow &&
+            (result < max_magnitude || (negative && result == max_magnitude));
+  return static_cast<int64_t>(negative ? 0 - result : result);
+#endif
+}
+
+// Returns (a * 2^shift) / b, rounded toward zero.
+// The dividend is computed in 128 bits, so the result is only wrong if it
+// does not fit in 64 bits.
+// |shift| must be in [1, 63], and |b| must not be 0.
+constexpr int64_t ShiftDivWide(int64_t a, int64_t b, int shift) {
+  bool success = true;
+  return ShiftDivWide(a, b, shift, success);
+}
+
+// Returns the integer square root of |value| (which must not be 0), as
+// historically computed by dux: floor(sqrt(value)), plus one when |value| is
+// one less than a perfect square.
+//
+// The Newton iteration is seeded with the smallest power of two greater than
+// the root, which is at most twice the root. The relative error then drops to
+// at most 1/4, 1/40, 3e-4, 5e-8 and 1e-15 after each step, so |kSteps| = 4 is
+// enough for values below 2^32, and 5 for values below 2^64. Since every step
+// rounds down, the iteration ends on floor(sqrt(value)) or one above it.
+template <typename UnsignedType, int kSteps>
+constexpr UnsignedType NewtonSqrt(UnsignedType value) {
+  assert(value != 0);
+  int bits = BitWidth(value);
+  UnsignedType n = static_cast<UnsignedType>(1) << ((bits + 1) / 2);
+  for (int i = 0; i < kSteps; i++) {
+    n = (n + value / n) >> 1;
+  }
+  n -= (n * n > value) ? 1 : 0;
+  // The previous implementation stopped one step after reaching the root,
+  // which moves it up by one when value == n * n + 2 * n.
+  n += (value - n * n == 2 * n) ? 1 : 0;
+  return n;
+}
+
+// Class encapsulating fixed point numbers with |kFracBits| fractional bits,
+// stored in a |RawT|.
+// The numbers of different precisions only convert explicitly into each other.
+template <typename RawT, int kFracBits>
+class Fixed {
  public:
-  using RawType = int64_t;
+  using RawType = RawT;
+  using WideType = typename WideRawType<RawT>::Type;
+
+  static_assert(std::is_signed_v<RawType>);
+  static_assert(kFracBits > 0 &&
+                kFracBits < static_cast<int>(8 * sizeof(RawType)) - 1);
 
   // Initializes to 0.
-  constexpr FInt() : raw_value_(0) {
+  constexpr Fixed() : raw_value_(0) {
     static_assert(kHalfShift * 2 == kShift);
-    static_assert(kFractionMask == (1 << kShift) - 1);
+    static_assert(kFractionMask == (RawType(1) << kShift) - 1);
     static_assert(kFractionMask == ~kIntegerMask);
   }
 
   // Copy constructor.
-  constexpr FInt(FInt const& o) = default;
+  constexpr Fixed(Fixed const& o) = default;
 
   // Copy assignment operator.
-  constexpr FInt& operator=(FInt const& o) = default;
+  constexpr Fixed& operator=(Fixed const& o) = default;
+
+  // Converts a fixed point number of another precision. The fractional bits
+  // that do not fit are truncated toward zero. The integral bits that do not
+  // fit are lost.
+  template <typename OtherRawT, int kOtherFracBits>
+  constexpr explicit Fixed(Fixed<OtherRawT, kOtherFracBits> const& o)
+      : raw_value_(ConvertRawValue<OtherRawT, kOtherFracBits>(o.raw_value_)) {}
 
   // Creates a fixed point number from an integer.
-  [[nodiscard]] constexpr static FInt FromInt(int32_t value) {
-    return FInt(static_cast<RawType>(value) * (1 << kShift));
+  [[nodiscard]] constexpr static Fixed FromInt(int32_t value) {
+    return Fixed(static_cast<RawType>(value) * (RawType(1) << kShift));
   }
 
   // Creates a fixed point number from the underlying representation.
-  [[nodiscard]] constexpr static FInt FromRawValue(RawType raw_value) {
-    return FInt(raw_value);
+  [[nodiscard]] constexpr static Fixed FromRawValue(RawType raw_value) {
+    return Fixed(raw_value);
   }
 
   // Creates a fixed point number from the result of the operation
   // numerator/denominator.
-  [[nodiscard]] constexpr static FInt FromFraction(int32_t numerator,
-                                                   int32_t denominator) {
+  [[nodiscard]] constexpr static Fixed FromFraction(int32_t numerator,
+                                                    int32_t denominator) {
     assert(denominator != 0);
-    FInt i = FromInt(numerator);
+    Fixed i = FromInt(numerator);
     i.raw_value_ /= denominator;
     return i;
   }
 
   // Creates a fixed point number from a double.
-  [[nodiscard]] constexpr static FInt FromDouble(double value) {
-    RawType raw_value = static_cast<RawType>(value * (1 << FInt::kShift));
-    return FInt::FromRawValue(raw_value);
+  [[nodiscard]] constexpr static Fixed FromDouble(double value) {
+    RawType raw_value =
+        static_cast<RawType>(value * static_cast<double>(kOne));
+    return Fixed::FromRawValue(raw_value);
   }
 
   // Creates a fixed point number from a float.
-  [[nodiscard]] constexpr static FInt FromFloat(float value) {
-    RawType raw_value = static_cast<RawType>(value * (1 << FInt::kShift));
-    return FInt::FromRawValue(raw_value);
+  [[nodiscard]] constexpr static Fixed FromFloat(float value) {
+    RawType raw_value = static_cast<RawType>(value * static_cast<float>(kOne));
+    return Fixed::FromRawValue(raw_value);
   }
 
   // Returns the integral part of the fixed point number.
   [[nodiscard]] constexpr int32_t Int32() const {
-    return static_cast<int32_t>(raw_value_ / (1 << kShift));
+    return static_cast<int32_t>(raw_value_ / kOne);
   }
 
   // Returns the integral part of the fixed point number.
-  [[nodiscard]] constexpr int64_t Int64() const {
-    return raw_value_ / (1 << kShift);
-  }
+  [[nodiscard]] constexpr int64_t Int64() const { return raw_value_ / kOne; }
 
   // Returns an approximation as a double of the fixed point number.
   [[nodiscard]] double DoubleValue() const;
@@ -77,28 +343,28 @@ class FInt {
   [[nodiscard]] float FloatValue() const;
 
   // Returns the absolute value of |this| object.
-  [[nodiscard]] constexpr FInt Abs() const {
+  [[nodiscard]] constexpr Fixed Abs() const {
     if (raw_value_ > 0) {
-      return FInt::FromRawValue(raw_value_);
+      return Fixed::FromRawValue(raw_value_);
     }
-    return FInt::FromRawValue(-raw_value_);
+    return Fixed::FromRawValue(-raw_value_);
   }
 
   // Return the largest integral fixed point number less than or equal to |this|
   // object.
-  [[nodiscard]] constexpr FInt Floor() const {
-    return FInt::FromRawValue(raw_value_ & kIntegerMask);
+  [[nodiscard]] constexpr Fixed Floor() const {
+    return Fixed::FromRawValue(raw_value_ & kIntegerMask);
   }
 
   // Return the smallest integral fixed point number greater than or equal to
   // |this| object.
-  [[nodiscard]] constexpr FInt Ceil() const {
-    return -FInt::FromRawValue(-raw_value_ & kIntegerMask);
+  [[nodiscard]] constexpr Fixed Ceil() const {
+    return -Fixed::FromRawValue(-raw_value_ & kIntegerMask);
   }
 
   // Returns the integral value nearest by rounding half-way cases away from
   // zero.
-  [[nodiscard]] constexpr FInt Round() const {
+  [[nodiscard]] constexpr Fixed Round() const {
     bool high_bit_of_fraction_is_one = (raw_value_ & kHighBitOfFraction) > 0;
     if (high_bit_of_fraction_is_one) {
       return Ceil();
@@ -107,148 +373,674 @@ class FInt {
   }
 
   // Returns the fractional part.
-  [[nodiscard]] constexpr FInt Frac() const {
-    return FInt::FromRawValue(Abs().raw_value_ & kFractionMask);
+  [[nodiscard]] constexpr Fixed Frac() const {
+    return Fixed::FromRawValue(Abs().raw_value_ & kFractionMask);
   }
 
   // Returns whether |other| is of the same sign as |this|.
   // Considers 0 as being a positive number.
-  [[nodiscard]] constexpr bool IsSameSignAs(const FInt& other) const {
+  [[nodiscard]] constexpr bool IsSameSignAs(const Fixed& other) const {
     return (raw_value_ ^ other.raw_value_) >= 0;
   }
 
   // Returns the non-negative square root of |this| object.
   // Asserts if |this| is less than zero.
-  [[nodiscard]] FInt Sqrt() const;
+  [[nodiscard]] constexpr Fixed Sqrt() const {
+    static_assert(kShift % 2 == 0, "The square root needs an even kShift.");
+    assert(raw_value_ >= 0);
+    if (raw_value_ <= 0) {
+      return Fixed(0);
+    }
+
+    RawType square_root_of_raw_value = 0;
+    // Specialisation for when the value fits in a int32_t: 32-bit divisions
+    // are cheaper, and fewer steps are needed.
+    if (raw_value_ < 0x7FFFFFFF) {
+      square_root_of_raw_value = static_cast<RawType>(
+          NewtonSqrt<uint32_t, 4>(static_cast<uint32_t>(raw_value_)));
+    } else {
+      square_root_of_raw_value = static_cast<RawType>(
+          NewtonSqrt<uint64_t, 5>(static_cast<uint64_t>(raw_value_)));
+    }
+    return Fixed::FromRawValue(square_root_of_raw_value << kHalfShift);
+  }
+
+  // Returns 1 / sqrt(|this|), rounded to the nearest value. The result is
+  // within one unit of the exact inverse square root.
+  // Asserts if |this| is less than or equal to zero.
+  [[nodiscard]] Fixed InvSqrt() const;
 
   // Returns a value that is always positive.
   // |upper_bound| must be greater than 0.
-  [[nodiscard]] FInt EuclideanDivisionRemainder(dux::FInt upper_bound) const;
+  [[nodiscard]] Fixed EuclideanDivisionRemainder(Fixed upper_bound) const;
 
   // Returns the string representation of a fixedpoint value
   // The returned string is formatted like a fixedpoint literal (-0.2048), not a
   // float (-0.5)
   [[nodiscard]] std::string ToString() const;
 
-  constexpr FInt operator+(const FInt& o) const {
-    return FInt::FromRawValue(raw_value_ + o.raw_value_);
+  // When DUX_FIXED_CHECKED_ARITHMETIC is defined, the arithmetic operators
+  // use the |Checked*| functions below, and abort the program when an
+  // operation overflows.
+  constexpr Fixed operator+(const Fixed& o) const {
+#if defined(DUX_FIXED_CHECKED_ARITHMETIC)
+    return ValueOrAbort(CheckedAdd(o));
+#else
+    return Fixed::FromRawValue(raw_value_ + o.raw_value_);
+#endif
   }
-  constexpr FInt operator-(const FInt& o) const {
-    return FInt::FromRawValue(raw_value_ - o.raw_value_);
+  constexpr Fixed operator-(const Fixed& o) const {
+#if defined(DUX_FIXED_CHECKED_ARITHMETIC)
+    return ValueOrAbort(CheckedSub(o));
+#else
+    return Fixed::FromRawValue(raw_value_ - o.raw_value_);
+#endif
   }
-  constexpr FInt operator*(const FInt& o) const {
-    return FInt::FromRawValue((raw_value_ * o.raw_value_) / (1 << kShift));
+  // When DUX_FIXED_WIDE_ARITHMETIC is defined, the multiplications and
+  // divisions use |MulWide| and |DivWide|. Otherwise, the intermediate results
+  // of |FInt| overflow when the product of the raw values, or the dividend
+  // times 2^kShift, does not fit in 64 bits.
+  constexpr Fixed operator*(const Fixed& o) const {
+#if defined(DUX_FIXED_CHECKED_ARITHMETIC)
+    return ValueOrAbort(CheckedMul(o));
+#elif defined(DUX_FIXED_WIDE_ARITHMETIC)
+    return MulWide(o);
+#else
+    return MulInWideType(o);
+#endif
   }
-  constexpr FInt operator/(const FInt& o) const {
-    return FInt::FromRawValue((raw_value_ * (1 << kShift)) / o.raw_value_);
+  constexpr Fixed operator/(const Fixed& o) const {
+#if defined(DUX_FIXED_CHECKED_ARITHMETIC)
+    return ValueOrAbort(CheckedDiv(o));
+#elif defined(DUX_FIXED_WIDE_ARITHMETIC)
+    return DivWide(o);
+#else
+    return DivInWideType(o);
+#endif
   }
-  constexpr FInt operator%(const FInt& o) const {
+
+  // Returns |this| * |o|, with an intermediate result twice as wide as
+  // |RawType|: only overflows when the result does not fit.
+  // Rounds like |operator*|.
+  [[nodiscard]] constexpr Fixed MulWide(const Fixed& o) const {
+    if constexpr (sizeof(WideType) > sizeof(RawType)) {
+      return MulInWideType(o);
+    } else {
+      return Fixed::FromRawValue(
+          MulShiftWide(raw_value_, o.raw_value_, kShift));
+    }
+  }
+
+  // Returns |this| / |o|, with an intermediate result twice as wide as
+  // |RawType|: only overflows when the result does not fit.
+  // Rounds like |operator/|.
+  [[nodiscard]] constexpr Fixed DivWide(const Fixed& o) const {
+    if constexpr (sizeof(WideType) > sizeof(RawType)) {
+      return DivInWideType(o);
+    } else {
+      return Fixed::FromRawValue(
+          ShiftDivWide(raw_value_, o.raw_value_, kShift));
+    }
+  }
+
+  // Returns 1 / |this|, rounded like |operator/|.
+  // Multiplying by the reciprocal is cheaper than dividing, but x *
+  // y.Reciprocal() differs from x / y by up to |x| + 1 units of 2^-kShift. Use
+  // |FIntDivisor| for exact divisions by the same value.
+  [[nodiscard]] constexpr Fixed Reciprocal() const {
+    return Fixed::FromInt(1) / *this;
+  }
+
+  // Returns |this| + |o|, or std::nullopt if the addition overflows.
+  [[nodiscard]] constexpr std::optional<Fixed> CheckedAdd(
+      const Fixed& o) const {
+    RawType result = 0;
+    if (AddOverflow(raw_value_, o.raw_value_, result)) {
+      return std::nullopt;
+    }
+    return Fixed::FromRawValue(result);
+  }
+
+  // Returns |this| - |o|, or std::nullopt if the subtraction overflows.
+  [[nodiscard]] constexpr std::optional<Fixed> CheckedSub(
+      const Fixed& o) const {
+    RawType result = 0;
+    if (SubOverflow(raw_value_, o.raw_value_, result)) {
+      return std::nullopt;
+    }
+    return Fixed::FromRawValue(result);
+  }
+
+  // Returns the result of |operator*|, or std::nullopt if it overflows: when
+  // the result does not fit, or, without DUX_FIXED_WIDE_ARITHMETIC, when the
+  // intermediate result does not fit.
+  [[nodiscard]] constexpr std::optional<Fixed> CheckedMul(
+      const Fixed& o) const {
+    if constexpr (sizeof(WideType) > sizeof(RawType)) {
+      return NarrowWideValue(
+          (static_cast<WideType>(raw_value_) * o.raw_value_) / kWideOne);
+    } else {
+#if defined(DUX_FIXED_WIDE_ARITHMETIC)
+      bool success = true;
+      RawType result = MulShiftWide(raw_value_, o.raw_value_, kShift, success);
+      if (!success) {
+        return std::nullopt;
+      }
+      return Fixed::FromRawValue(result);
+#else
+      RawType product = 0;
+      if (MulOverflow(raw_value_, o.raw_value_, product)) {
+        return std::nullopt;
+      }
+      return Fixed::FromRawValue(product / kOne);
+#endif
+    }
+  }
+
+  // Returns the result of |operator/|, or std::nullopt if |o| is 0 or if it
+  // overflows: when the result does not fit, or, without
+  // DUX_FIXED_WIDE_ARITHMETIC, when the intermediate result does not fit.
+  [[nodiscard]] constexpr std::optional<Fixed> CheckedDiv(
+      const Fixed& o) const {
+    if (o.raw_value_ == 0) {
+      return std::nullopt;
+    }
+    if constexpr (sizeof(WideType) > sizeof(RawType)) {
+      return NarrowWideValue((static_cast<WideType>(raw_value_) * kWideOne) /
+                             o.raw_value_);
+    } else {
+#if defined(DUX_FIXED_WIDE_ARITHMETIC)
+      bool success = true;
+      RawType result = ShiftDivWide(raw_value_, o.raw_value_, kShift, success);
+      if (!success) {
+        return std::nullopt;
+      }
+      return Fixed::FromRawValue(result);
+#else
+      RawType dividend = 0;
+      if (MulOverflow(raw_value_, kOne, dividend) ||
+          (dividend == std::numeric_limits<RawType>::min() &&
+           o.raw_value_ == -1)) {
+        return std::nullopt;
+      }
+      return Fixed::FromRawValue(dividend / o.raw_value_);
+#endif
+    }
+  }
+
+  // Returns |this| + |o|, clamped to the range of |RawType|.
+  [[nodiscard]] constexpr Fixed SaturatingAdd(const Fixed& o) const {
+    RawType result = 0;
+    if (AddOverflow(raw_value_, o.raw_value_, result)) {
+      return raw_value_ < 0 ? Lowest() : Highest();
+    }
+    return Fixed::FromRawValue(result);
+  }
+
+  // Returns |this| - |o|, clamped to the range of |RawType|.
+  [[nodiscard]] constexpr Fixed SaturatingSub(const Fixed& o) const {
+    RawType result = 0;
+    if (SubOverflow(raw_value_, o.raw_value_, result)) {
+      return raw_value_ < 0 ? Lowest() : Highest();
+    }
+    return Fixed::FromRawValue(result);
+  }
+
+  // Returns |this| * |o|, rounded like |operator*| and clamped to the range of
+  // |RawType|. The intermediate result never overflows.
+  [[nodiscard]] constexpr Fixed SaturatingMul(const Fixed& o) const {
+    if constexpr (sizeof(WideType) > sizeof(RawType)) {
+      return ClampWideValue(
+          (static_cast<WideType>(raw_value_) * o.raw_value_) / kWideOne);
+    } else {
+      bool success = true;
+      RawType result = MulShiftWide(raw_value_, o.raw_value_, kShift, success);
+      if (!success) {
+        return IsSameSignAs(o) ? Highest() : Lowest();
+      }
+      return Fixed::FromRawValue(result);
+    }
+  }
+
+  // Returns |this| / |o|, rounded like |operator/| and clamped to the range of
+  // |RawType|. The intermediate result never overflows.
+  // |o| must not be 0.
+  [[nodiscard]] constexpr Fixed SaturatingDiv(const Fixed& o) const {
     assert(o.raw_value_ != 0);
-    return dux::FInt::FromRawValue(raw_value_ % o.raw_value_);
+    if constexpr (sizeof(WideType) > sizeof(RawType)) {
+      return ClampWideValue((static_cast<WideType>(raw_value_) * kWideOne) /
+                            o.raw_value_);
+    } else {
+      bool success = true;
+      RawType result = ShiftDivWide(raw_value_, o.raw_value_, kShift, success);
+      if (!success) {
+        return IsSameSignAs(o) ? Highest() : Lowest();
+      }
+      return Fixed::FromRawValue(result);
+    }
   }
-  constexpr FInt operator-() const {
-    return dux::FInt::FromRawValue(-raw_value_);
+
+  constexpr Fixed operator%(const Fixed& o) const {
+    assert(o.raw_value_ != 0);
+    return Fixed::FromRawValue(raw_value_ % o.raw_value_);
+  }
+  constexpr Fixed operator-() const {
+#if defined(DUX_FIXED_CHECKED_ARITHMETIC)
+    return ValueOrAbort(Fixed().CheckedSub(*this));
+#else
+    return Fixed::FromRawValue(-raw_value_);
+#endif
   }
 
-  constexpr FInt operator++() {
-    raw_value_ += (1 << kShift);
+  constexpr Fixed operator++() {
+    *this += Fixed::FromRawValue(kOne);
     return *this;
   }
-  constexpr FInt operator--() {
-    raw_value_ -= (1 << kShift);
+  constexpr Fixed operator--() {
+    *this -= Fixed::FromRawValue(kOne);
     return *this;
   }
 
-  constexpr void operator+=(const FInt& o) { raw_value_ += o.raw_value_; }
-  constexpr void operator-=(const FInt& o) { raw_value_ -= o.raw_value_; }
-  constexpr void operator*=(const FInt& o) {
-    raw_value_ *= o.raw_value_;
-    raw_value_ /= (1 << kShift);
-  }
-  constexpr void operator/=(const FInt& o) {
-    raw_value_ *= (1 << kShift);
+  constexpr void operator+=(const Fixed& o) { *this = *this + o; }
+  constexpr void operator-=(const Fixed& o) { *this = *this - o; }
+  constexpr void operator*=(const Fixed& o) { *this = *this * o; }
+  constexpr void operator/=(const Fixed& o) {
     assert(o.raw_value_ != 0);
-    raw_value_ /= o.raw_value_;
+    *this = *this / o;
   }
-  constexpr void operator%=(const FInt& o) {
+  constexpr void operator%=(const Fixed& o) {
     assert(o.raw_value_ != 0);
     raw_value_ %= o.raw_value_;
   }
-  constexpr void operator>>=(int shift) { raw_value_ /= (1 << shift); }
-  constexpr void operator<<=(int shift) { raw_value_ *= (1 << shift); }
+  constexpr void operator>>=(int shift) {
+    raw_value_ /= (RawType(1) << shift);
+  }
+  constexpr void operator<<=(int shift) {
+    raw_value_ *= (RawType(1) << shift);
+  }
 
-  constexpr bool operator!=(const FInt& o) const {
+  constexpr bool operator!=(const Fixed& o) const {
     return raw_value_ != o.raw_value_;
   }
-  constexpr bool operator==(const FInt& o) const {
+  constexpr bool operator==(const Fixed& o) const {
     return raw_value_ == o.raw_value_;
   }
-  constexpr bool operator<(const FInt& o) const {
+  constexpr bool operator<(const Fixed& o) const {
     return raw_value_ < o.raw_value_;
   }
-  constexpr bool operator<=(const FInt& o) const {
+  constexpr bool operator<=(const Fixed& o) const {
     return raw_value_ <= o.raw_value_;
   }
-  constexpr bool operator>(const FInt& o) const {
+  constexpr bool operator>(const Fixed& o) const {
     return raw_value_ > o.raw_value_;
   }
-  constexpr bool operator>=(const FInt& o) const {
+  constexpr bool operator>=(const Fixed& o) const {
     return raw_value_ >= o.raw_value_;
   }
 
-  constexpr FInt operator>>(int shift) const {
-    return dux::FInt::FromRawValue(raw_value_ >> shift);
+  constexpr Fixed operator>>(int shift) const {
+    return Fixed::FromRawValue(raw_value_ >> shift);
   }
-  constexpr FInt operator<<(int shift) const {
-    return dux::FInt::FromRawValue(raw_value_ << shift);
+  constexpr Fixed operator<<(int shift) const {
+    return Fixed::FromRawValue(raw_value_ << shift);
   }
 
   template <typename T>
-  constexpr FInt operator*(const T v) const {
+  constexpr Fixed operator*(const T v) const {
     static_assert(std::is_integral_v<T>, "Integer required.");
-    return dux::FInt::FromRawValue(raw_value_ * static_cast<RawType>(v));
+#if defined(DUX_FIXED_CHECKED_ARITHMETIC)
+    RawType result = 0;
+    if (MulOverflow(raw_value_, static_cast<RawType>(v), result)) {
+      Abort();
+    }
+    return Fixed::FromRawValue(result);
+#else
+    return Fixed::FromRawValue(raw_value_ * static_cast<RawType>(v));
+#endif
   }
 
   template <typename T>
-  constexpr FInt operator/(const T v) const {
+  constexpr Fixed operator/(const T v) const {
     static_assert(std::is_integral_v<T>, "Integer required.");
-    return dux::FInt::FromRawValue(raw_value_ / static_cast<RawType>(v));
+#if defined(DUX_FIXED_CHECKED_ARITHMETIC)
+    // Only the signed divisors can be -1. The unsigned ones as wide as
+    // |RawType| wrap around to -1 when converted.
+    if constexpr (std::is_signed_v<T> || sizeof(T) >= sizeof(RawType)) {
+      if (raw_value_ == std::numeric_limits<RawType>::min() &&
+          static_cast<RawType>(v) == RawType(-1)) {
+        Abort();
+      }
+    }
+#endif
+    return Fixed::FromRawValue(raw_value_ / static_cast<RawType>(v));
   }
 
   template <typename T>
   constexpr void operator*=(const T v) {
     static_assert(std::is_integral_v<T>, "Integer required.");
+#if defined(DUX_FIXED_CHECKED_ARITHMETIC)
+    *this = *this * v;
+#else
     raw_value_ *= v;
+#endif
   }
 
   template <typename T>
   constexpr void operator/=(const T v) {
     static_assert(std::is_integral_v<T>, "Integer required.");
+#if defined(DUX_FIXED_CHECKED_ARITHMETIC)
+    *this = *this / v;
+#else
     raw_value_ /= v;
+#endif
   }
 
   RawType raw_value_;
-  static constexpr int kShift = 12;
-  static constexpr RawType kFractionMask = (1 << kShift) - 1;
-  static constexpr RawType kHighBitOfFraction = (1 << (kShift - 1));
-  static constexpr RawType kIntegerMask = ~((1 << kShift) - 1);
+  static constexpr int kShift = kFracBits;
+  static constexpr RawType kFractionMask = (RawType(1) << kShift) - 1;
+  static constexpr RawType kHighBitOfFraction = (RawType(1) << (kShift - 1));
+  static constexpr RawType kIntegerMask = ~((RawType(1) << kShift) - 1);
   static constexpr int kHalfShift = kShift / 2;
 
  private:
+  static constexpr RawType kOne = RawType(1) << kShift;
+  static constexpr WideType kWideOne = WideType(1) << kShift;
+
   // Private. Use |FromRawValue| instead.
-  constexpr explicit FInt(RawType raw_value) : raw_value_(raw_value) {}
+  constexpr explicit Fixed(RawType raw_value) : raw_value_(raw_value) {}
+
+  static constexpr Fixed Highest() {
+    return Fixed::FromRawValue(std::numeric_limits<RawType>::max());
+  }
+  static constexpr Fixed Lowest() {
+    return Fixed::FromRawValue(std::numeric_limits<RawType>::min());
+  }
+
+  // Returns |value| if it fits in |RawType|, std::nullopt otherwise.
+  static constexpr std::optional<Fixed> NarrowWideValue(WideType value) {
+    if (value > std::numeric_limits<RawType>::max() ||
+        value < std::numeric_limits<RawType>::min()) {
+      return std::nullopt;
+    }
+    return Fixed::FromRawValue(static_cast<RawType>(value));
+  }
+
+  // Returns |value| clamped to the range of |RawType|.
+  static constexpr Fixed ClampWideValue(WideType value) {
+    if (value > std::numeric_limits<RawType>::max()) {
+      return Highest();
+    }
+    if (value < std::numeric_limits<RawType>::min()) {
+      return Lowest();
+    }
+    return Fixed::FromRawValue(static_cast<RawType>(value));
+  }
+
+  // Called by the checked operators when an operation overflows.
+  [[noreturn]] static void Abort() {
+    assert(false && "Fixed point overflow");
+    std::abort();
+  }
+
+  static constexpr Fixed ValueOrAbort(std::optional<Fixed> result) {
+    if (!result) {
+      Abort();
+    }
+    return *result;
+  }
+
+  constexpr Fixed MulInWideType(const Fixed& o) const {
+    return Fixed::FromRawValue(static_cast<RawType>(
+        (static_cast<WideType>(raw_value_) * o.raw_value_) / kWideOne));
+  }
+  constexpr Fixed DivInWideType(const Fixed& o) const {
+    return Fixed::FromRawValue(static_cast<RawType>(
+        (static_cast<WideType>(raw_value_) * kWideOne) / o.raw_value_));
+  }
+
+  template <typename OtherRawT, int kOtherFracBits>
+  static constexpr RawType ConvertRawValue(OtherRawT raw_value) {
+    // Converts in the largest of the two types.
+    using Intermediate =
+        std::conditional_t<(sizeof(OtherRawT) > sizeof(RawType)), OtherRawT,
+                           RawType>;
+    Intermediate value = raw_value;
+    if constexpr (kOtherFracBits > kShift) {
+      value /= Intermediate(1) << (kOtherFracBits - kShift);
+    } else if constexpr (kOtherFracBits < kShift) {
+      value *= Intermediate(1) << (kShift - kOtherFracBits);
+    }
+    return static_cast<RawType>(value);
+  }
 };
 
+// Q51.12 fixed point numbers, the precision used by the rest of the library.
+using FInt = Fixed<int64_t, 12>;
+
+// Q19.12 fixed point numbers, with the same fractional bits as |FInt| in half
+// the memory. Meant for storing large amounts of values, e.g. coordinates,
+// that are widened to |FInt| for the computations.
+using FInt32 = Fixed<int32_t, 12>;
+
+// The non-inline functions are explicitly instantiated in the library for
+// Fixed<int64_t, 12>, Fixed<int64_t, 16>, Fixed<int64_t, 20>,
+// Fixed<int32_t, 12> and Fixed<int32_t, 16>, unless DUX_FIXED_HEADER_ONLY is
+// defined.
+
+// |Pow|, |Exp|, |Ln| and |Fixed::Sqrt| are constexpr, so that curves and
+// tables of values can be computed at compile time, and are defined in the
+// header, so that they inline into the loops calling them.
+
 // Returns x^y
 // Disclaimer: when `y` is not an integer, the precision is low.
-[[nodiscard]] FInt Pow(FInt x, FInt y);
+template <typename RawT, int kFracBits>
+[[nodiscard]] constexpr Fixed<RawT, kFracBits> Pow(
+    Fixed<RawT, kFracBits> const x,
+    Fixed<RawT, kFracBits> const y) {
+  using F = Fixed<RawT, kFracBits>;
+  using RawType = typename F::RawType;
+  F const one = F::FromInt(1);
+  if (y.raw_value_ == 0) {
+    return one;  // x^0 = 1
+  }
+  if (x.raw_value_ == 0) {
+    return F();  // 0^y = 0  if y!=0
+  }
+
+  bool y_is_negative = y < F();
+  F const positive_y = y_is_negative ? -y : y;
+  RawType fractional_y = positive_y.raw_value_ & F::kFractionMask;
+  RawType integral_y = positive_y.raw_value_ & F::kIntegerMask;
+  F result = one;
+  F squared = x;
+  if (integral_y) {
+    while (integral_y > F::kFractionMask) {
+      if ((integral_y & (RawType(1) << F::kShift)) != 0) {
+        result *= squared;
+      }
+      squared = (squared * squared);
+      integral_y >>= 1;
+    }
+  }
+  auto square_rooted = x;
+  while (fractional_y != 0) {
+    square_rooted = square_rooted.Sqrt();
+    if (square_rooted == one) {
+      break;
+    }
+    if (fractional_y & F::kHighBitOfFraction) {
+      result *= square_rooted;
+    }
+    fractional_y <<= 1;
+    fractional_y &= F::kFractionMask;
+  }
+  if (y_is_negative) {
+    return one / result;
+  }
+  return result;
+}
+
+// Fixed-point constants for Exp() and Ln().
+// ln(2) in Q51.12 format is 0.693147 * 4096 ~= 2839
+template <typename FixedT>
+inline constexpr FixedT kLn2 = FixedT::FromDouble(0.69314718055994530942);
+// 1/ln(2) in Q51.12 format is 1.442695 * 4096 ~= 5909
+template <typename FixedT>
+inline constexpr FixedT kInvLn2 = FixedT::FromDouble(1.44269504088896340736);
+static_assert(kLn2<FInt>.raw_value_ == 2839);
+static_assert(kInvLn2<FInt>.raw_value_ == 5909);
 
 // Returns e^x, the base-e exponential of x.
-[[nodiscard]] FInt Exp(FInt x);
+template <typename RawT, int kFracBits>
+[[nodiscard]] constexpr Fixed<RawT, kFracBits> Exp(Fixed<RawT, kFracBits> x) {
+  using F = Fixed<RawT, kFracBits>;
+  if (x == F()) {
+    return F::FromInt(1);
+  }
+
+  // Clamp input to prevent overflow. The largest value for FInt is ~2^51.
+  // ln(2^51) = 51 * ln(2) ~= 35.3. We clamp around this value.
+  constexpr int kIntegerBits = 8 * sizeof(RawT) - 1 - F::kShift;
+  constexpr F kMaxArgument = F::FromInt(static_cast<int32_t>(
+      kIntegerBits * 0.69314718055994530942));
+  if (x > kMaxArgument) {
+    return F::FromRawValue(std::numeric_limits<RawT>::max());
+  }
+  // For large negative x, e^x underflows to 0.
+  if (x < -kMaxArgument) {
+    return F();
+  }
+
+  // Range reduction: e^x = 2^k * e^(x'), where x' = x - k*ln(2) and |x'| <=
+  // ln(2)/2. First, find k = round(x / ln(2)) = round(x * (1/ln(2))).
+  F k_fint = x * kInvLn2<F>;
+  int32_t k = k_fint.Round().Int32();
+
+  // Then, find x' = x - k * ln(2).
+  F x_prime = x - (F::FromInt(k) * kLn2<F>);
+
+  // Calculate e^(x') using Taylor series: 1 + x' + (x')^2/2! + (x')^3/3! ...
+  F sum = F::FromInt(1) + x_prime;
+  F term = x_prime;
+
+  // With range reduction, the series converges quickly. 10-12 terms are ample.
+  for (int i = 2; i < 12; ++i) {
+    term = (term * x_prime) / i;
+    // Once the term is too small to contribute, we can stop.
+    if (term.raw_value_ == 0) {
+      break;
+    }
+    sum += term;
+  }
+
+  // Final result is sum * 2^k. This is a bit shift on the raw value.
+  if (k > 0) {
+    // Prevent overflow from the shift. A left shift by ~50 is the max.
+    if (k >= kIntegerBits - 1) {
+      return F::FromRawValue(std::numeric_limits<RawT>::max());
+    }
+    return F::FromRawValue(sum.raw_value_ << k);
+  }
+  if (k < 0) {
+    int rshift = -k;
+    // Prevent shifting by more than the bit width.
+    if (rshift >= static_cast<int>(8 * sizeof(RawT))) {
+      return F();
+    }
+    return F::FromRawValue(sum.raw_value_ >> rshift);
+  }
+  // if k == 0
+  return sum;
+}
+
+// Returns the natural logarithm of x.
+// Asserts if x <= 0.
+template <typename RawT, int kFracBits>
+[[nodiscard]] constexpr Fixed<RawT, kFracBits> Ln(Fixed<RawT, kFracBits> x) {
+  using F = Fixed<RawT, kFracBits>;
+  F const one = F::FromInt(1);
+  F const two = F::FromInt(2);
+  assert(x > F() && "Logarithm argument must be positive");
+  if (x <= F()) {
+    // Return error value
+    return F::FromRawValue(std::numeric_limits<RawT>::min());
+  }
+
+  // 1) Extract integer power of 2: x = y * 2^k, with y in [1,2).
+  int32_t k = 0;
+  F y = x;
+  // bring y into [1,2)
+  while (y > two) {
+    y.raw_value_ >>= 1;
+    ++k;
+  }
+  while (y < one) {
+    y.raw_value_ <<= 1;
+    --k;
+  }
+
+  // 2) Compute ln(y) via the atanh-series:
+  //    z = (y - 1) / (y + 1)
+  //    ln(y) = 2 * ( z + z^3/3 + z^5/5 + … )
+  F z = (y - one) / (y + one);
+  F z2 = z * z;
+  F term = z;
+  F sum = term;
+  // sum odd terms
+  for (int n = 3; n <= 11; n += 2) {
+    term = term * z2;
+    sum += (term / F::FromInt(n));
+  }
+  F ln_y = sum * two;
+
+  // 3) Reassemble: ln(x) = k*ln(2) + ln(y)
+  return F::FromInt(k) * kLn2<F> + ln_y;
+}
+
+// Fixed cost counterparts of |Exp|, |Ln| and |Pow|, for evaluating them in
+// bulk. They normalize their argument with a count of leading zeros, and use
+// tables and short polynomials instead of loops and divisions: |FastLn|
+// looks up a 128-entry table of logarithms over [1, 2[, |FastExp| a 256-entry
+// table of powers of two over [0, 1[, and |FastPow| both. With these sizes,
+// the polynomials are within 2^-34 (logarithms) and 2^-38 (powers of two),
+// and the intermediate results, which have 32 fractional bits, within 2^-31.
+// They are thus more precise than |Exp|, |Ln| and |Pow| (see
+// bench/bench_fixed_int.cpp):
+// - |FastExp| and |FastLn| are within one unit of the exact result, plus a
+//   relative error of 2^-28 for |FastExp|.
+// - |FastPow| has a relative error below 2^-26 * (1 + |y * log2(x)|), plus
+//   one unit.
+// Unlike |Exp|, |FastExp| only saturates when e^x does not fit.
+
+// Returns e^x.
+template <typename RawT, int kFracBits>
+[[nodiscard]] Fixed<RawT, kFracBits> FastExp(Fixed<RawT, kFracBits> x);
 
 // Returns the natural logarithm of x.
 // Asserts if x <= 0.
-[[nodiscard]] FInt Ln(FInt x);
+template <typename RawT, int kFracBits>
+[[nodiscard]] Fixed<RawT, kFracBits> FastLn(Fixed<RawT, kFracBits> x);
+
+// Returns x^y.
+// Asserts if x < 0 and y is not an integer.
+template <typename RawT, int kFracBits>
+[[nodiscard]] Fixed<RawT, kFracBits> FastPow(Fixed<RawT, kFracBits> x,
+                                             Fixed<RawT, kFracBits> y);
+
+// The pi constants of each precision. Half pi is rounded to the nearest
+// value, and the others are exact multiples of it, so that angles fold
+// exactly between the quadrants.
+template <typename FixedT>
+inline constexpr FixedT FixedHalfPi = FixedT::FromRawValue(
+    static_cast<typename FixedT::RawType>(1.57079632679489661923 *
+                                              (int64_t(1) << FixedT::kShift) +
+                                          0.5));
+template <typename FixedT>
+inline constexpr FixedT FixedQuarterPi = FixedHalfPi<FixedT> / 2;
+template <typename FixedT>
+inline constexpr FixedT FixedPi = FixedHalfPi<FixedT> * 2;
+template <typename FixedT>
+inline constexpr FixedT FixedTwoPi = FixedHalfPi<FixedT> * 4;
 
 constexpr FInt FIntMax =
     FInt::FromRawValue(std::numeric_limits<dux::FInt::RawType>::max());
@@ -266,11 +1058,134 @@ constexpr FInt FIntQuarterPi = FInt::FromRawValue(3217LL);
 constexpr FInt FIntPi = FInt::FromRawValue(12868LL);
 constexpr FInt FIntTwoPi = FInt::FromRawValue(25736LL);
 
+static_assert(FIntHalfPi == FixedHalfPi<FInt>);
+static_assert(FIntQuarterPi == FixedQuarterPi<FInt>);
+static_assert(FIntPi == FixedPi<FInt>);
+static_assert(FIntTwoPi == FixedTwoPi<FInt>);
+
+constexpr FInt32 FInt32Max =
+    FInt32::FromRawValue(std::numeric_limits<FInt32::RawType>::max());
+constexpr FInt32 FInt32Min =
+    FInt32::FromRawValue(std::numeric_limits<FInt32::RawType>::min());
+
+// Returns |value| as a |FInt|. Never loses precision.
+[[nodiscard]] constexpr FInt Widen(FInt32 value) {
+  return FInt::FromRawValue(value.raw_value_);
+}
+
+// Returns whether |value| can be stored in a |FInt32| without loss.
+[[nodiscard]] constexpr bool FitsInFInt32(FInt value) {
+  return value >= Widen(FInt32Min) && value <= Widen(FInt32Max);
+}
+
+// Returns |value| as a |FInt32|, clamped to [FInt32Min, FInt32Max].
+[[nodiscard]] constexpr FInt32 NarrowSaturated(FInt value) {
+  // Selects instead of branching, so that loops narrowing arrays vectorize.
+  constexpr int64_t kMax = FInt32Max.raw_value_;
+  constexpr int64_t kMin = FInt32Min.raw_value_;
+  int64_t raw_value = value.raw_value_;
+  raw_value = raw_value > kMax ? kMax : raw_value;
+  raw_value = raw_value < kMin ? kMin : raw_value;
+  return FInt32::FromRawValue(static_cast<int32_t>(raw_value));
+}
+
+// Returns |value| as a |FInt32|.
+// |success| is set to false if |value| does not fit, in which case the
+// returned value is clamped like |NarrowSaturated|.
+[[nodiscard]] constexpr FInt32 Narrow(FInt value, bool& success) {
+  success = FitsInFInt32(value);
+  return NarrowSaturated(value);
+}
+
+// Returns 2^62 / sqrt(value), with a relative error below 2^-29.
+// Only uses integer operations: a table gives a first approximation, which a
+// Newton iteration refines.
+// |value| must not be 0.
+uint64_t ScaledInverseSqrt(uint64_t value);
+
+// Scales the vector whose components are |components| to a length of
+// |length|, with one |ScaledInverseSqrt| and a multiplication per component.
+// The components are within one unit of the exact ones when |length| is at
+// most 2^16.
+// Returns false, and leaves the components untouched, if they are all 0.
+// Inline, so that the components of the callers stay in registers.
+template <size_t kCount>
+inline bool NormalizeComponents(FInt (&components)[kCount], FInt length) {
+  static_assert(kCount >= 1 && kCount <= 4);
+  // The signs are applied with masks rather than branches, which would be
+  // mispredicted for vectors pointing anywhere. The widest magnitude is found
+  // with a width per component rather than by or-ing the magnitudes, which
+  // compilers vectorize with costly moves through memory.
+  uint64_t sign_masks[kCount];
+  uint64_t magnitudes[kCount];
+  int width = 0;
+  for (size_t i = 0; i < kCount; i++) {
+    sign_masks[i] = static_cast<uint64_t>(components[i].raw_value_ >> 63);
+    magnitudes[i] =
+        (static_cast<uint64_t>(components[i].raw_value_) ^ sign_masks[i]) -
+        sign_masks[i];
+    int component_width = BitWidth(magnitudes[i]);
+    width = component_width > width ? component_width : width;
+  }
+  if (width == 0) {
+    return false;
+  }
+  // Scales the magnitudes so that the largest is in [2^29, 2^30[: the sum of
+  // their squares fits in 64 bits, and each product with the inverse square
+  // root is at most 2^62.
+  int shift = width - 30;
+  int right_shift = shift > 0 ? shift : 0;
+  int left_shift = shift > 0 ? 0 : -shift;
+  uint64_t square_length = 0;
+  for (size_t i = 0; i < kCount; i++) {
+    magnitudes[i] = (magnitudes[i] << left_shift) >> right_shift;
+    square_length += magnitudes[i] * magnitudes[i];
+  }
+  uint64_t inverse_length = ScaledInverseSqrt(square_length);
+  uint64_t length_sign_mask = static_cast<uint64_t>(length.raw_value_ >> 63);
+  uint64_t length_magnitude =
+      (static_cast<uint64_t>(length.raw_value_) ^ length_sign_mask) -
+      length_sign_mask;
+  for (size_t i = 0; i < kCount; i++) {
+    // The component of the unit vector in Q31.
+    uint64_t unit = (magnitudes[i] * inverse_length) >> 31;
+    // unit * length / 2^31, rounded to the nearest value. The product fits in
+    // 64 bits for the usual lengths.
+    uint64_t result;
+    if (length_magnitude <= UINT32_MAX) {
+      result = (unit * length_magnitude + (uint64_t(1) << 30)) >> 31;
+    } else {
+      uint64_t high = 0;
+      uint64_t low = 0;
+      MulU64(unit, length_magnitude, high, low);
+      uint64_t rounded_low = low + (uint64_t(1) << 30);
+      high += rounded_low < low ? 1 : 0;
+      result = (rounded_low >> 31) | (high << 33);
+    }
+    uint64_t sign_mask = sign_masks[i] ^ length_sign_mask;
+    components[i] = FInt::FromRawValue(
+        static_cast<int64_t>((result ^ sign_mask) - sign_mask));
+  }
+  return true;
+}
+
 // Returns the angle interpolation between `angle_start` and `angle_end`.
 // `percentage` should be a number between 0 and 1.
-dux::FInt InterpolateAngle(dux::FInt angle_start,
-                           dux::FInt angle_end,
-                           dux::FInt percentage);
+template <typename RawT, int kFracBits>
+constexpr Fixed<RawT, kFracBits> InterpolateAngle(
+    Fixed<RawT, kFracBits> angle_start,
+    Fixed<RawT, kFracBits> angle_end,
+    Fixed<RawT, kFracBits> percentage) {
+  using F = Fixed<RawT, kFracBits>;
+  F d_angle = angle_end - angle_start;
+  if (d_angle >= -FixedPi<F> && d_angle <= FixedPi<F>) {
+    return angle_start + d_angle * percentage;
+  }
+  d_angle = (angle_end - angle_start) % FixedTwoPi<F>;
+  F short_angle = ((F::FromInt(2) * d_angle) % FixedTwoPi<F>) - d_angle;
+  return angle_start + short_angle * percentage;
+}
+
 }  // namespace dux
 
 // A shorthand for |dux::FInt::FromInt|:
@@ -281,6 +1196,12 @@ constexpr dux::FInt operator""_fx(unsigned long long int v) {
   return dux::FInt::FromRawValue(v * (1 << dux::FInt::kShift));
 }
 
-std::ostream& operator<<(std::ostream& stream, const dux::FInt& fint);
+template <typename RawT, int kFracBits>
+std::ostream& operator<<(std::ostream& stream,
+                         const dux::Fixed<RawT, kFracBits>& fixed);
+
+#if defined(DUX_FIXED_HEADER_ONLY)
+#include "fixed_int.cpp"
+#endif
 
 #endif  // DUX_FIXED_SRC_FIXED_INT_H_
@@ -0,0 +1,20 @@
+#ifndef DUX_FIXED_SRC_FIXED_SIMD_H_
+#define DUX_FIXED_SRC_FIXED_SIMD_H_
+
+// Internal helpers for the SIMD code paths. Not part of the public API.
+//
+// The SIMD functions are compiled with target attributes, so that the library
+// itself does not require any instruction set flag. Callers must check
+// |dux::batch::IsBackendSupported| before running them.
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define DUX_FIXED_X86_SIMD 1
+#include <immintrin.h>
+#define DUX_FIXED_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define DUX_FIXED_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DUX_FIXED_X86_SIMD 0
+#endif
+
+#endif  // DUX_FIXED_SRC_FIXED_SIMD_H_
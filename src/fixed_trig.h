@@ -1,31 +1,118 @@
 #ifndef DUX_FILED_SRC_FIXED_TRIG_H_
 #define DUX_FILED_SRC_FIXED_TRIG_H_
 
+#include <cstddef>
+#include <cstdint>
+
 #include "fixed_int.h"
 
 namespace dux::trig {
 
+// The divisions of the angle normalization and of the lookup table index are
+// replaced by multiplications with fixed point reciprocals:
+// for 0 <= n < 2^b and d > 0, n / d == (n * m) >> s
+// when m = ceil(2^s / d) and m * d - 2^s <= 2^(s - b).
+
+// Angles whose raw value is in ]-kAngleReductionLimit, kAngleReductionLimit[
+// are normalized with a multiplication.
+constexpr FInt::RawType kAngleReductionLimit = FInt::RawType(1) << 31;
+constexpr int kTwoPiReciprocalShift = 46;
+constexpr uint64_t kTwoPiReciprocal =
+    ((uint64_t(1) << kTwoPiReciprocalShift) + FIntTwoPi.raw_value_ - 1) /
+    FIntTwoPi.raw_value_;
+static_assert(kTwoPiReciprocal < (uint64_t(1) << 32),
+              "Must fit in the 32x32 bits SIMD multiplications");
+static_assert(kTwoPiReciprocal * FIntTwoPi.raw_value_ -
+                      (uint64_t(1) << kTwoPiReciprocalShift) <=
+                  (uint64_t(1) << (kTwoPiReciprocalShift - 31)),
+              "Must be exact below kAngleReductionLimit");
+
+// The index of an angle a in [0, PI/2] in the lookup table of cos values is
+//   ((a * 512) / FIntHalfPi).Round()
+// = floor(floor(a * 512 * 2^12 / h) / 2^12 + 1/2)
+// = floor((a * 512 + h / 2) / h)
+// where h is the raw value of |FIntHalfPi|. For a in [0, 2*PI],
+// a * 512 + h / 2 < 2^24.
+constexpr int kCosTableIndexShift = 37;
+constexpr uint64_t kCosTableIndexReciprocal =
+    ((uint64_t(1) << kCosTableIndexShift) + FIntHalfPi.raw_value_ - 1) /
+    FIntHalfPi.raw_value_;
+static_assert(FIntHalfPi.raw_value_ % 2 == 0);
+static_assert(FIntTwoPi.raw_value_ * 512 + FIntHalfPi.raw_value_ / 2 <
+              (1 << 24));
+static_assert(kCosTableIndexReciprocal < (uint64_t(1) << 32),
+              "Must fit in the 32x32 bits SIMD multiplications");
+static_assert(kCosTableIndexReciprocal * FIntHalfPi.raw_value_ -
+                      (uint64_t(1) << kCosTableIndexShift) <=
+                  (uint64_t(1) << (kCosTableIndexShift - 24)),
+              "Must be exact for all the angles in [0, 2*PI]");
+
+// Returns |angle| normalized to [0, 2*PI].
+// Negative multiples of 2*PI are normalized to 2*PI.
+constexpr FInt NormalizeAngle(FInt angle) {
+  FInt::RawType raw_angle = angle.raw_value_;
+  if (raw_angle >= 0 && raw_angle <= FIntTwoPi.raw_value_) {
+    return angle;
+  }
+  if (raw_angle <= -kAngleReductionLimit ||
+      raw_angle >= kAngleReductionLimit) {
+    if (raw_angle < 0) {
+      return FIntTwoPi - (-angle) % FIntTwoPi;
+    }
+    return angle % FIntTwoPi;
+  }
+  uint64_t magnitude = raw_angle < 0 ? -raw_angle : raw_angle;
+  FInt::RawType remainder =
+      magnitude -
+      ((magnitude * kTwoPiReciprocal) >> kTwoPiReciprocalShift) *
+          FIntTwoPi.raw_value_;
+  return FInt::FromRawValue(raw_angle < 0 ? FIntTwoPi.raw_value_ - remainder
+                                          : remainder);
+}
+
+// Returns ((angle * 512) / FIntHalfPi).Round().Int32() for |angle| in
+// [0, 2*PI], without division. For |angle| in [0, PI/2], this is the index of
+// |angle| in the lookup table of cos values.
+constexpr uint32_t CosTableIndex(FInt angle) {
+  uint64_t n = angle.raw_value_ * 512 + FIntHalfPi.raw_value_ / 2;
+  return static_cast<uint32_t>((n * kCosTableIndexReciprocal) >>
+                               kCosTableIndexShift);
+}
+
+// |Cos|, |Sin|, |Sincos| and |Atan2| are constexpr, so that rotation tables
+// can be computed at compile time. They are defined in fixed_trig_table.h,
+// next to the tables they read.
+
 // Returns the cosinus of the radian angle |angle|.
-FInt Cos(FInt angle);
+constexpr FInt Cos(FInt angle);
 
 // Returns the sinus of the radian angle |angle|.
-FInt Sin(FInt angle);
+constexpr FInt Sin(FInt angle);
 
 // Stores the sinus and cosinus of the radian angle |angle| in |sin| and |cos|.
-void Sincos(FInt angle, FInt& sin, FInt& cos);
+constexpr void Sincos(FInt angle, FInt& sin, FInt& cos);
+
+// Stores the sinus and cosinus of the |count| radian angles |angles| in |sin|
+// and |cos|, which must have room for |count| values.
+// Gives the same results as |Sincos|, but replaces its divisions with
+// multiplications and its branches with masks, and uses AVX2 gathers when it
+// is the active |dux::batch| backend.
+void SincosN(FInt const* angles, FInt* sin, FInt* cos, size_t count);
 
 // Returns the principal value of the arc tangent of y/x.
 // Returns a value in the range [0, 2*pi[.
-FInt Atan2(FInt y, FInt x);
+// The angle is folded to the first octant and read from an interpolated table
+// of arc tangents, so the cost does not depend on the angle.
+constexpr FInt Atan2(FInt y, FInt x);
 
 // Returns an angle in radians from an angle in degrees.
 constexpr FInt ToRadian(FInt angle) {
   return FInt((angle * FIntTwoPi) / 360);
 }
 
-// Generates and prints the lookup tables used in the implementation.
-void GenerateLookupTables();
-
 }  // namespace dux::trig
 
+// The definitions of the constexpr functions above.
+#include "fixed_trig_table.h"
+
 #endif  // DUX_FILED_SRC_FIXED_TRIG_H_
@@ -0,0 +1,444 @@
+#ifndef DUX_FIXED_SRC_FIXED_TRIG_TABLE_H_
+#define DUX_FIXED_SRC_FIXED_TRIG_TABLE_H_
+
+#include <array>
+#include <cstdint>
+
+#include "fixed_int.h"
+#include "fixed_trig.h"
+
+namespace dux::trig {
+
+// Number of fractional bits of the values of the |CosTable|s.
+constexpr int kCosTableShift = 28;
+
+// Returns the cosinus of |x|, which must be in [0, PI/2], with an error below
+// 1e-15. Used to generate the tables at compile time, where std::cos is not
+// available.
+constexpr double ConstexprCos(double x) {
+  // Taylor series. The terms decrease below 1e-17 after the 12th one.
+  double x_squared = x * x;
+  double term = 1;
+  double sum = 1;
+  for (int i = 1; i <= 12; i++) {
+    term *= -x_squared / ((2 * i - 1) * (2 * i));
+    sum += term;
+  }
+  return sum;
+}
+
+// Returns n / kDivisor for n in [0, 2^kBits[, using a multiplication instead
+// of a division:
+// n / d == (n * m) >> s when m = ceil(2^s / d) and m * d - 2^s <= 2^(s - b).
+// Falls back to a division when n * m could overflow.
+template <uint64_t kDivisor, int kBits>
+constexpr uint64_t DivideWithReciprocal(uint64_t n) {
+  if constexpr (2 * kBits + 1 > 64) {
+    return n / kDivisor;
+  } else {
+    constexpr int kDivisorBits = [] {
+      int bits = 0;
+      while ((uint64_t(1) << bits) < kDivisor) {
+        bits++;
+      }
+      return bits;
+    }();
+    constexpr int kShift = kBits + kDivisorBits;
+    constexpr uint64_t kMultiplier =
+        ((uint64_t(1) << kShift) + kDivisor - 1) / kDivisor;
+    static_assert(kMultiplier * kDivisor - (uint64_t(1) << kShift) <=
+                  (uint64_t(1) << (kShift - kBits)));
+    return (n * kMultiplier) >> kShift;
+  }
+}
+
+// Cos of |kSegments| + 1 angles evenly spaced in [0, PI/2], with
+// |kCosTableShift| fractional bits, generated at compile time.
+template <uint32_t kSegments>
+struct CosTable {
+  static_assert(kSegments >= 1 && kSegments <= 16384);
+
+  static constexpr std::array<int32_t, kSegments + 1> Generate() {
+    constexpr double kPi = 3.14159265358979323846;
+    std::array<int32_t, kSegments + 1> values = {};
+    for (uint32_t i = 0; i <= kSegments; i++) {
+      double value = ConstexprCos(i * (kPi / (2 * kSegments)));
+      values[i] = static_cast<int32_t>(value * (1 << kCosTableShift) + 0.5);
+    }
+    return values;
+  }
+
+  static constexpr std::array<int32_t, kSegments + 1> kValues = Generate();
+};
+
+// Number of fractional bits of the values of the |AtanTable|s.
+constexpr int kAtanTableShift = 28;
+
+// Returns the arc tangent of |x|, which must be in [0, 1], with an error below
+// 1e-15.
+constexpr double ConstexprAtan(double x) {
+  // atan(x) = PI/4 - atan((1 - x) / (1 + x)) keeps the argument of the Taylor
+  // series below tan(PI/8), where the terms decrease below 1e-17 after the
+  // 22nd one.
+  constexpr double kQuarterPi = 0.78539816339744830962;
+  bool reflected = x > 0.41421356237309504880;
+  double u = reflected ? (1 - x) / (1 + x) : x;
+  double u_squared = u * u;
+  double power = u;
+  double sum = u;
+  for (int i = 1; i <= 22; i++) {
+    power *= -u_squared;
+    sum += power / (2 * i + 1);
+  }
+  return reflected ? kQuarterPi - sum : sum;
+}
+
+// Arc tangent of |kSegments| + 1 ratios evenly spaced in [0, 1], with
+// |kAtanTableShift| fractional bits, generated at compile time.
+template <uint32_t kSegments>
+struct AtanTable {
+  static_assert(kSegments >= 1 && kSegments <= 16384);
+
+  static constexpr std::array<int32_t, kSegments + 1> Generate() {
+    std::array<int32_t, kSegments + 1> values = {};
+    for (uint32_t i = 0; i <= kSegments; i++) {
+      double value = ConstexprAtan(static_cast<double>(i) / kSegments);
+      values[i] = static_cast<int32_t>(value * (1 << kAtanTableShift) + 0.5);
+    }
+    return values;
+  }
+
+  static constexpr std::array<int32_t, kSegments + 1> kValues = Generate();
+};
+
+enum class Interpolation {
+  // Returns the value of the nearest entry of the table. The entries are
+  // truncated to |FInt| like |FInt::FromDouble| does, so that
+  // TableTrig<512, Interpolation::kNearest> gives the same results as |Cos|,
+  // |Sin| and |Sincos|.
+  kNearest,
+  // Interpolates linearly between the two surrounding entries of the table.
+  kLinear,
+};
+
+// Returns |angle| normalized to [0, 2*PI], for the precisions other than
+// |FInt|, which has a faster overload.
+template <typename RawT, int kFracBits>
+constexpr Fixed<RawT, kFracBits> NormalizeAngle(
+    Fixed<RawT, kFracBits> angle) {
+  using F = Fixed<RawT, kFracBits>;
+  if (angle < F()) {
+    return FixedTwoPi<F> - (-angle) % FixedTwoPi<F>;
+  } else if (angle > FixedTwoPi<F>) {
+    return angle % FixedTwoPi<F>;
+  }
+  return angle;
+}
+
+// Sinus and cosinus of |FixedT| angles read from a |CosTable| of |kSegments|
+// segments per quarter of circle.
+// The tables with more segments and the linear interpolation reduce the
+// stepping of the results, e.g. when rotating long vectors, at the cost of
+// cache footprint and latency. The benchmarks measure the trade-off.
+template <uint32_t kSegments,
+          Interpolation kInterpolation,
+          typename FixedT = FInt>
+class TableTrig {
+ public:
+  // Returns the cosinus of the radian angle |angle|.
+  static constexpr FixedT Cos(FixedT angle) {
+    FixedT sin;
+    FixedT cos;
+    SincosImpl<false>(angle, sin, cos);
+    return cos;
+  }
+
+  // Returns the sinus of the radian angle |angle|.
+  static constexpr FixedT Sin(FixedT angle) {
+    return Cos(FixedHalfPi<FixedT> - angle);
+  }
+
+  // Stores the sinus and cosinus of the radian angle |angle| in |sin| and
+  // |cos|.
+  static constexpr void Sincos(FixedT angle, FixedT& sin, FixedT& cos) {
+    SincosImpl<true>(angle, sin, cos);
+  }
+
+ private:
+  // The intermediate values are computed in 64 bits for every precision.
+  using RawType = int64_t;
+  static_assert(FixedT::kShift < kCosTableShift);
+  static constexpr RawType kHalfPi = FixedHalfPi<FixedT>.raw_value_;
+  static constexpr std::array<int32_t, kSegments + 1> const& kTable =
+      CosTable<kSegments>::kValues;
+  // Bits of the numerators divided by |kHalfPi|.
+  static constexpr int kIndexBits = [] {
+    int bits = 0;
+    while ((RawType(1) << bits) <= kHalfPi * (2 * kSegments + 1)) {
+      bits++;
+    }
+    return bits;
+  }();
+  // Bits of the numerators of the interpolation weights.
+  static constexpr int kWeightBits = [] {
+    int bits = 0;
+    while ((RawType(1) << bits) <= (kHalfPi << 16)) {
+      bits++;
+    }
+    return bits;
+  }();
+
+  // Returns the index of the entry nearest to |angle| in [0, PI/2]:
+  // floor((angle * 2 * kSegments + kHalfPi) / (2 * kHalfPi)).
+  static constexpr uint32_t NearestIndex(RawType angle) {
+    return static_cast<uint32_t>(DivideWithReciprocal<2 * kHalfPi, kIndexBits>(
+        angle * 2 * kSegments + kHalfPi));
+  }
+
+  // Returns the raw value of the entry |index| truncated to a |FixedT|.
+  static constexpr RawType TruncatedEntry(uint32_t index) {
+    return kTable[index] >> (kCosTableShift - FixedT::kShift);
+  }
+
+  // Returns the cosinus of |angle| in [0, PI/2] interpolated between the
+  // entries of the table, rounded to a |FixedT|.
+  static constexpr RawType InterpolatedQuarterCos(RawType angle) {
+    RawType position = angle * kSegments;
+    uint32_t index = static_cast<uint32_t>(
+        DivideWithReciprocal<kHalfPi, kIndexBits>(position));
+    if (index == kSegments) {
+      index = kSegments - 1;
+    }
+    // The weight of the next entry, with 16 fractional bits.
+    RawType weight =
+        static_cast<RawType>(DivideWithReciprocal<kHalfPi, kWeightBits>(
+            (position - index * kHalfPi) << 16));
+    // The cosinus decreases over [0, PI/2].
+    RawType delta = kTable[index] - kTable[index + 1];
+    RawType value = kTable[index] - ((delta * weight) >> 16);
+    constexpr int kShift = kCosTableShift - FixedT::kShift;
+    return (value + (RawType(1) << (kShift - 1))) >> kShift;
+  }
+
+  template <bool kWithSin>
+  static constexpr void SincosImpl(FixedT angle, FixedT& sin, FixedT& cos) {
+    RawType a = NormalizeAngle(angle).raw_value_;
+    // Folds |a| to [0, PI/2], see |Sincos|. The cosinus is negative in the
+    // quadrants 1 and 2, the sinus in the quadrants 2 and 3.
+    bool negative_cos = false;
+    bool negative_sin = false;
+    if (a < 2 * kHalfPi) {
+      if (a >= kHalfPi) {
+        a = 2 * kHalfPi - a;
+        negative_cos = true;
+      }
+    } else {
+      negative_sin = true;
+      if (a < 3 * kHalfPi) {
+        a -= 2 * kHalfPi;
+        negative_cos = true;
+      } else {
+        a = 4 * kHalfPi - a;
+      }
+    }
+
+    RawType cos_value = 0;
+    RawType sin_value = 0;
+    if constexpr (kInterpolation == Interpolation::kNearest) {
+      uint32_t index = NearestIndex(a);
+      cos_value = TruncatedEntry(index);
+      if constexpr (kWithSin) {
+        sin_value = TruncatedEntry(kSegments - index);
+      }
+    } else {
+      cos_value = InterpolatedQuarterCos(a);
+      if constexpr (kWithSin) {
+        sin_value = InterpolatedQuarterCos(kHalfPi - a);
+      }
+    }
+    using FixedRawType = typename FixedT::RawType;
+    cos = FixedT::FromRawValue(
+        static_cast<FixedRawType>(negative_cos ? -cos_value : cos_value));
+    sin = FixedT::FromRawValue(
+        static_cast<FixedRawType>(negative_sin ? -sin_value : sin_value));
+  }
+};
+
+// Number of segments of the table of arc tangents over [0, 1] used by
+// |Atan2|. The error of the linear interpolation, below segment^2 / 8, is
+// negligible.
+constexpr uint32_t kAtanSegments = 256;
+
+// Returns the arc tangent of |numerator| / |denominator|, in [0, PI/4] and
+// with |kFracBits| fractional bits, where numerator <= denominator and
+// denominator > 0.
+template <int kFracBits>
+constexpr int64_t OctantAtan(uint64_t numerator, uint64_t denominator) {
+  static_assert(kFracBits < kAtanTableShift);
+  constexpr std::array<int32_t, kAtanSegments + 1> const& kTable =
+      AtanTable<kAtanSegments>::kValues;
+  assert(numerator <= denominator && denominator > 0);
+  // The ratio has |kRatioShift| fractional bits. Large values lose their low
+  // bits so that the numerator can be shifted without overflowing.
+  constexpr int kRatioShift = 24;
+  while (denominator >= (uint64_t(1) << (63 - kRatioShift))) {
+    numerator >>= 8;
+    denominator >>= 8;
+  }
+  uint64_t ratio = (numerator << kRatioShift) / denominator;
+
+  // Interpolates linearly between the two surrounding entries.
+  constexpr int kWeightShift = kRatioShift - 8;
+  static_assert(kAtanSegments == 1 << 8);
+  uint32_t index = static_cast<uint32_t>(ratio >> kWeightShift);
+  if (index == kAtanSegments) {
+    index = kAtanSegments - 1;
+  }
+  int64_t weight = ratio - (uint64_t(index) << kWeightShift);
+  int64_t delta = kTable[index + 1] - kTable[index];
+  int64_t value = kTable[index] + ((delta * weight) >> kWeightShift);
+  constexpr int kShift = kAtanTableShift - kFracBits;
+  return (value + (int64_t(1) << (kShift - 1))) >> kShift;
+}
+
+// The trigonometric functions of fixed_trig.h for all the precisions. The
+// overloads taking a |FInt| are preferred over these ones.
+
+template <typename RawT, int kFracBits>
+constexpr Fixed<RawT, kFracBits> Cos(Fixed<RawT, kFracBits> angle) {
+  return TableTrig<512, Interpolation::kNearest,
+                   Fixed<RawT, kFracBits>>::Cos(angle);
+}
+
+template <typename RawT, int kFracBits>
+constexpr Fixed<RawT, kFracBits> Sin(Fixed<RawT, kFracBits> angle) {
+  return TableTrig<512, Interpolation::kNearest,
+                   Fixed<RawT, kFracBits>>::Sin(angle);
+}
+
+template <typename RawT, int kFracBits>
+constexpr void Sincos(Fixed<RawT, kFracBits> angle,
+                      Fixed<RawT, kFracBits>& sin,
+                      Fixed<RawT, kFracBits>& cos) {
+  TableTrig<512, Interpolation::kNearest, Fixed<RawT, kFracBits>>::Sincos(
+      angle, sin, cos);
+}
+
+template <typename RawT, int kFracBits>
+constexpr Fixed<RawT, kFracBits> Atan2(Fixed<RawT, kFracBits> y,
+                                       Fixed<RawT, kFracBits> x) {
+  using F = Fixed<RawT, kFracBits>;
+  constexpr int64_t kHalfPi = FixedHalfPi<F>.raw_value_;
+  if (x.raw_value_ == 0) {
+    if (y.raw_value_ > 0) {
+      return FixedHalfPi<F>;
+    } else {
+      return FixedPi<F> + FixedHalfPi<F>;
+    }
+  }
+  // Folds the angle to the first octant, where the ratio of the smallest
+  // magnitude to the largest one is in [0, 1].
+  uint64_t abs_x = x.raw_value_ < 0 ? 0 - static_cast<uint64_t>(x.raw_value_)
+                                    : x.raw_value_;
+  uint64_t abs_y = y.raw_value_ < 0 ? 0 - static_cast<uint64_t>(y.raw_value_)
+                                    : y.raw_value_;
+  int64_t angle = abs_y > abs_x
+                      ? kHalfPi - OctantAtan<kFracBits>(abs_x, abs_y)
+                      : OctantAtan<kFracBits>(abs_y, abs_x);
+  if (x.raw_value_ < 0) {
+    angle = 2 * kHalfPi - angle;
+  }
+  if (y.raw_value_ < 0) {
+    angle = 4 * kHalfPi - angle;
+    // Angles too close to 0 to be distinguished from it.
+    if (angle == 4 * kHalfPi) {
+      angle = 0;
+    }
+  }
+  return F::FromRawValue(static_cast<RawT>(angle));
+}
+
+// Cos values between 0 and PI/2, truncated to |FInt| like
+// |FInt::FromDouble| does. Read by |Cos|, |Sin| and |Sincos|.
+inline constexpr std::array<int16_t, 513> kFIntCosTable = [] {
+  std::array<int16_t, 513> table = {};
+  for (size_t i = 0; i < table.size(); i++) {
+    table[i] = static_cast<int16_t>(CosTable<512>::kValues[i] >>
+                                    (kCosTableShift - FInt::kShift));
+  }
+  return table;
+}();
+
+// The trigonometric functions of fixed_trig.h for |FInt|.
+
+constexpr FInt Cos(FInt angle) {
+  angle = NormalizeAngle(angle);
+
+  if (angle < FIntPi) {
+    if (angle < FIntHalfPi) {
+      return FInt::FromRawValue(kFIntCosTable[CosTableIndex(angle)]);
+    } else {
+      angle = FIntPi - angle;
+      return FInt::FromRawValue(-kFIntCosTable[CosTableIndex(angle)]);
+    }
+  } else {
+    if (angle < FIntPi + FIntHalfPi) {
+      angle -= FIntPi;
+      return FInt::FromRawValue(-kFIntCosTable[CosTableIndex(angle)]);
+    } else {
+      angle = FIntTwoPi - angle;
+      return FInt::FromRawValue(kFIntCosTable[CosTableIndex(angle)]);
+    }
+  }
+}
+
+constexpr FInt Sin(FInt angle) {
+  return Cos(FIntHalfPi - angle);
+}
+
+constexpr void Sincos(FInt angle, FInt& sin, FInt& cos) {
+  angle = NormalizeAngle(angle);
+
+  if (angle < FIntPi) {
+    if (angle < FIntHalfPi) {
+      uint32_t index = CosTableIndex(angle);
+      assert(index <= 512);
+      cos = FInt::FromRawValue(kFIntCosTable[index]);
+      sin = FInt::FromRawValue(kFIntCosTable[512 - index]);
+    } else {
+      angle = FIntPi - angle;
+      uint32_t index = CosTableIndex(angle);
+      assert(index <= 512);
+      cos = FInt::FromRawValue(-kFIntCosTable[index]);
+      sin = FInt::FromRawValue(kFIntCosTable[512 - index]);
+    }
+  } else {
+    if (angle < FIntPi + FIntHalfPi) {
+      angle -= FIntPi;
+      uint32_t index = CosTableIndex(angle);
+      assert(index <= 512);
+      cos = FInt::FromRawValue(-kFIntCosTable[index]);
+      sin = FInt::FromRawValue(-kFIntCosTable[512 - index]);
+    } else {
+      angle = FIntTwoPi - angle;
+      uint32_t index = CosTableIndex(angle);
+      assert(index <= 512);
+      cos = FInt::FromRawValue(kFIntCosTable[index]);
+      sin = FInt::FromRawValue(-kFIntCosTable[512 - index]);
+    }
+  }
+}
+
+constexpr FInt Atan2(FInt y, FInt x) {
+  return Atan2<FInt::RawType, FInt::kShift>(y, x);
+}
+
+}  // namespace dux::trig
+
+// Included at the end of this header, which is completed after fixed_trig.h
+// whichever of the two is included first.
+#if defined(DUX_FIXED_HEADER_ONLY)
+#include "fixed_trig.cpp"
+#endif
+
+#endif  // DUX_FIXED_SRC_FIXED_TRIG_TABLE_H_
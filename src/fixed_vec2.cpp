@@ -1,21 +1,12 @@
 #include "fixed_vec2.h"
 #include "fixed_trig.h"
 
+#include <algorithm>
 #include <array>
 
 namespace dux {
 
-FInt FVec2::SquareLength() const {
-  return x_ * x_ + y_ * y_;
-}
-
-FInt FVec2::SquareLengthFrom(FVec2 const& c) const {
-  FInt dx = c.x_ - x_;
-  FInt dy = c.y_ - y_;
-  return dx * dx + dy * dy;
-}
-
-FInt FVec2::Length() {
+DUX_FIXED_INLINE FInt FVec2::Length() {
   // This works poorly with x_ and y_ that are very small:
   // If x_ is less than 0.015625 (sqrt(4096)/4096), x_*x_ results in 0, even
   // though sqrt(x_*x_) would not be 0.
@@ -32,7 +23,27 @@ FInt FVec2::Length() {
   return ((x_ * x_) + (y_ * y_)).Sqrt();
 }
 
-void FVec2::Normalize(bool& success) {
+DUX_FIXED_INLINE void FVec2::Normalize(bool& success) {
+  Normalize(success, 1_fx);
+}
+
+DUX_FIXED_INLINE void FVec2::Normalize(bool& success, FInt newLength) {
+  FInt components[] = {x_, y_};
+  success = NormalizeComponents(components, newLength);
+  if (success) {
+    x_ = components[0];
+    y_ = components[1];
+  }
+}
+
+DUX_FIXED_INLINE FVec2 FVec2::Normalized() const {
+  FVec2 v = *this;
+  bool success;
+  v.Normalize(success);
+  return v;
+}
+
+DUX_FIXED_INLINE void FVec2::NormalizeWithDivision(bool& success) {
   FInt l = Length();
   if (l.raw_value_ != 0) {
     x_ /= l;
@@ -43,7 +54,8 @@ void FVec2::Normalize(bool& success) {
   }
 }
 
-void FVec2::Normalize(bool& success, FInt newLength) {
+DUX_FIXED_INLINE void FVec2::NormalizeWithDivision(bool& success,
+                                                   FInt newLength) {
   FInt l = Length();
   if (l.raw_value_ != 0) {
     newLength = newLength / l;
@@ -55,16 +67,7 @@ void FVec2::Normalize(bool& success, FInt newLength) {
   }
 }
 
-FInt FVec2::DotProduct(const FVec2& v) const {
-  return (x_ * v.x_) + (y_ * v.y_);
-}
-
-void FVec2::Rotate90Deg() {
-  std::swap(x_, y_);
-  x_ = -x_;
-}
-
-void FVec2::Rotate(dux::FInt angle) {
+DUX_FIXED_INLINE void FVec2::Rotate(dux::FInt angle) {
   dux::FInt sinn;
   dux::FInt coss;
   dux::trig::Sincos(angle, sinn, coss);
@@ -73,90 +76,53 @@ void FVec2::Rotate(dux::FInt angle) {
   x_ = new_x;
 }
 
-void FVec2::Init(FInt x, FInt y) {
-  x_ = x;
-  y_ = y;
-}
-
-FVec2 FVec2::FromAngle(FInt angle, FInt radius) {
+DUX_FIXED_INLINE FVec2 FVec2::FromAngle(FInt angle, FInt radius) {
   FVec2 v;
   dux::trig::Sincos(angle, v.y_, v.x_);
   v *= radius;
   return v;
 }
 
-FVec2 FVec2::FromAngle(FInt angle) {
+DUX_FIXED_INLINE FVec2 FVec2::FromAngle(FInt angle) {
   FVec2 v;
   dux::trig::Sincos(angle, v.y_, v.x_);
   return v;
 }
 
-FVec2 FVec2::operator+(const FVec2& a) const {
-  FVec2 v(a.x_ + x_, a.y_ + y_);
-  return v;
-}
-
-void FVec2::operator+=(const FVec2& a) {
-  x_ += a.x_;
-  y_ += a.y_;
-}
-
-FVec2 FVec2::operator-(const FVec2& a) const {
-  FVec2 c(x_ - a.x_, y_ - a.y_);
-  return c;
-}
-
-FVec2 FVec2::operator-() const {
-  FVec2 c(-x_, -y_);
-  return c;
-}
-
-void FVec2::operator-=(const FVec2& a) {
-  x_ -= a.x_;
-  y_ -= a.y_;
-}
-
-FInt FVec2::operator*(const FVec2& a) const {
-  return (x_ * a.x_ + y_ * a.y_);
-}
-
-FVec2 FVec2::operator*(FInt v) const {
-  FVec2 c(x_ * v, y_ * v);
-  return c;
-}
-
-void FVec2::operator*=(FInt v) {
-  x_ *= v;
-  y_ *= v;
-}
-
-FVec2 FVec2::operator*(const int32_t s) const {
-  FVec2 v(x_ * s, y_ * s);
-  return v;
-}
-
-FVec2 FVec2::operator/(const int32_t s) const {
-  FVec2 v(x_ / s, y_ / s);
-  return v;
-}
-
-void FVec2::operator*=(const int32_t s) {
-  x_ *= s;
-  y_ *= s;
+DUX_FIXED_INLINE void FVec2::FromAngles(FInt const* angles,
+                                        FInt radius,
+                                        FVec2* out,
+                                        size_t count) {
+  FromAngles(angles, out, count);
+  for (size_t i = 0; i < count; i++) {
+    out[i] *= radius;
+  }
 }
 
-void FVec2::operator/=(const int32_t s) {
-  x_ /= s;
-  y_ /= s;
+DUX_FIXED_INLINE void FVec2::FromAngles(FInt const* angles,
+                                        FVec2* out,
+                                        size_t count) {
+  constexpr size_t kBlockSize = 256;
+  std::array<FInt, kBlockSize> sin;
+  std::array<FInt, kBlockSize> cos;
+  for (size_t begin = 0; begin < count; begin += kBlockSize) {
+    size_t block_count = std::min(kBlockSize, count - begin);
+    dux::trig::SincosN(angles + begin, sin.data(), cos.data(), block_count);
+    for (size_t i = 0; i < block_count; i++) {
+      out[begin + i].x_ = cos[i];
+      out[begin + i].y_ = sin[i];
+    }
+  }
 }
 
-FInt FVec2::Angle() const {
+DUX_FIXED_INLINE FInt FVec2::Angle() const {
   return dux::trig::Atan2(y_, x_);
 }
 
 }  // namespace dux
 
-std::ostream& operator<<(std::ostream& stream, const dux::FVec2& fvec2) {
+DUX_FIXED_INLINE std::ostream& operator<<(std::ostream& stream,
+                                         const dux::FVec2& fvec2) {
   stream << "(" << fvec2.x_ << "," << fvec2.y_ << ")";
   return stream;
 }
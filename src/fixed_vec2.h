@@ -1,6 +1,7 @@
 #ifndef DUX_FILED_SRC_FIXED_VEC2_H_
 #define DUX_FILED_SRC_FIXED_VEC2_H_
 
+#include <cstddef>
 #include <sstream>
 
 #include "fixed_int.h"
@@ -17,54 +18,108 @@ class FVec2 {
   constexpr FVec2(FInt x, FInt y) : x_(x), y_(y) {}
   constexpr FVec2(int x, int y) : x_(FInt::FromInt(x)), y_(FInt::FromInt(y)) {}
 
-  void Init(FInt x, FInt y);
+  constexpr void Init(FInt x, FInt y) {
+    x_ = x;
+    y_ = y;
+  }
   static FVec2 FromAngle(FInt angle, FInt radius);
   static FVec2 FromAngle(FInt angle);
+  // Stores |FromAngle| of the |count| angles |angles| in |out|, using
+  // |trig::SincosN|.
+  static void FromAngles(FInt const* angles, FInt radius, FVec2* out,
+                         size_t count);
+  static void FromAngles(FInt const* angles, FVec2* out, size_t count);
 
-  FInt SquareLength() const;
-  FInt SquareLengthFrom(FVec2 const&) const;
+  constexpr FInt SquareLength() const { return x_ * x_ + y_ * y_; }
+  constexpr FInt SquareLengthFrom(FVec2 const& c) const {
+    FInt dx = c.x_ - x_;
+    FInt dy = c.y_ - y_;
+    return dx * dx + dy * dy;
+  }
   FInt Length();
+  // Scales the vector to a length of 1 (or |newLength|) with one
+  // |ScaledInverseSqrt| and a multiplication per component: see
+  // |NormalizeComponents| for the precision.
+  // |success| is set to false, and the vector left untouched, if it is null.
   void Normalize(bool& success);
   void Normalize(bool& success, FInt newLength);
-  FInt DotProduct(const FVec2& v) const;
+  // Returns the vector scaled to a length of 1, or the null vector if it is
+  // null.
+  [[nodiscard]] FVec2 Normalized() const;
+  // The former |Normalize|, which divides the components by |Length()|. Kept
+  // for the code depending on its exact results.
+  void NormalizeWithDivision(bool& success);
+  void NormalizeWithDivision(bool& success, FInt newLength);
+  constexpr FInt DotProduct(const FVec2& v) const {
+    return (x_ * v.x_) + (y_ * v.y_);
+  }
   // Returns a value in the range [0, 2*pi[.
   FInt Angle() const;
-  void Rotate90Deg();
+  constexpr void Rotate90Deg() {
+    FInt x = x_;
+    x_ = -y_;
+    y_ = x;
+  }
   void Rotate(dux::FInt angle);
 
-  FVec2 operator+(const FVec2&) const;
-  FVec2 operator-(const FVec2&) const;
-  FInt operator*(const FVec2&) const;
-  FVec2 operator-() const;
-  FVec2 operator*(FInt) const;
+  constexpr FVec2 operator+(const FVec2& a) const {
+    return FVec2(x_ + a.x_, y_ + a.y_);
+  }
+  constexpr FVec2 operator-(const FVec2& a) const {
+    return FVec2(x_ - a.x_, y_ - a.y_);
+  }
+  constexpr FInt operator*(const FVec2& a) const {
+    return (x_ * a.x_ + y_ * a.y_);
+  }
+  constexpr FVec2 operator-() const { return FVec2(-x_, -y_); }
+  constexpr FVec2 operator*(FInt v) const { return FVec2(x_ * v, y_ * v); }
 
-  void operator+=(const FVec2&);
-  void operator-=(const FVec2&);
-  void operator*=(FInt);
+  constexpr void operator+=(const FVec2& a) {
+    x_ += a.x_;
+    y_ += a.y_;
+  }
+  constexpr void operator-=(const FVec2& a) {
+    x_ -= a.x_;
+    y_ -= a.y_;
+  }
+  constexpr void operator*=(FInt v) {
+    x_ *= v;
+    y_ *= v;
+  }
 
-  FVec2 operator*(const int32_t s) const;
-  FVec2 operator/(const int32_t s) const;
-  void operator*=(const int32_t s);
-  void operator/=(const int32_t s);
+  constexpr FVec2 operator*(const int32_t s) const {
+    return FVec2(x_ * s, y_ * s);
+  }
+  constexpr FVec2 operator/(const int32_t s) const {
+    return FVec2(x_ / s, y_ / s);
+  }
+  constexpr void operator*=(const int32_t s) {
+    x_ *= s;
+    y_ *= s;
+  }
+  constexpr void operator/=(const int32_t s) {
+    x_ /= s;
+    y_ /= s;
+  }
 
-  inline bool operator==(const FVec2& other) const {
+  constexpr bool operator==(const FVec2& other) const {
     return x_ == other.x_ && y_ == other.y_;
   }
-  inline bool operator!=(const FVec2& other) const {
+  constexpr bool operator!=(const FVec2& other) const {
     return x_ != other.x_ || y_ != other.y_;
   }
 
   // Returns true if the inequality is true for both |x_| and |y_|.
-  inline bool operator>=(const FVec2& other) const {
+  constexpr bool operator>=(const FVec2& other) const {
     return x_ >= other.x_ && y_ >= other.y_;
   }
-  inline bool operator<=(const FVec2& other) const {
+  constexpr bool operator<=(const FVec2& other) const {
     return x_ <= other.x_ && y_ <= other.y_;
   }
-  inline bool operator>(const FVec2& other) const {
+  constexpr bool operator>(const FVec2& other) const {
     return x_ > other.x_ && y_ > other.y_;
   }
-  inline bool operator<(const FVec2& other) const {
+  constexpr bool operator<(const FVec2& other) const {
     return x_ < other.x_ && y_ < other.y_;
   }
 };
@@ -73,4 +128,8 @@ class FVec2 {
 
 std::ostream& operator<<(std::ostream& stream, const dux::FVec2& fvec2);
 
+#if defined(DUX_FIXED_HEADER_ONLY)
+#include "fixed_vec2.cpp"
+#endif
+
 #endif  // DUX_FILED_SRC_FIXED_VEC2_H_
@@ -0,0 +1,178 @@
+#include "fixed_vec2_array.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "fixed_batch.h"
+#include "fixed_trig.h"
+
+namespace dux::internal {
+
+using RawType = dux::FInt::RawType;
+
+// The passes needing temporary values process the arrays in blocks, so that
+// the temporary values live on the stack and stay in the L1 cache.
+constexpr size_t kBlockSize = 256;
+
+static_assert(sizeof(FInt) == sizeof(RawType));
+
+DUX_FIXED_INLINE RawType* RawValues(FInt* values) {
+  return reinterpret_cast<RawType*>(values);
+}
+
+// Stores the |FVec2::Length| of the |count| vectors (x[i], y[i]) in |out|.
+DUX_FIXED_INLINE void BlockLength(RawType const* x,
+                                  RawType const* y,
+                                  size_t count,
+                                  FInt* out) {
+  RawType y_squared[kBlockSize];
+  assert(count <= kBlockSize);
+  RawType* raw_out = RawValues(out);
+  dux::batch::Mul(x, x, raw_out, count);
+  dux::batch::Mul(y, y, y_squared, count);
+  dux::batch::Add(raw_out, y_squared, raw_out, count);
+  // See |FVec2::Length|: short vectors are scaled up before squaring them.
+  constexpr RawType kLimit = FInt::FromFraction(1, 10).raw_value_;
+  for (size_t i = 0; i < count; i++) {
+    if (x[i] < kLimit && x[i] > -kLimit && y[i] < kLimit && y[i] > -kLimit) {
+      out[i] = dux::FVec2(FInt::FromRawValue(x[i]), FInt::FromRawValue(y[i]))
+                   .Length();
+    } else {
+      out[i] = out[i].Sqrt();
+    }
+  }
+}
+
+}  // namespace dux::internal
+
+namespace dux {
+
+DUX_FIXED_INLINE FVec2Array::FVec2Array(size_t size)
+    : x_(size, 0), y_(size, 0) {}
+
+DUX_FIXED_INLINE void FVec2Array::Resize(size_t size) {
+  x_.resize(size, 0);
+  y_.resize(size, 0);
+}
+
+DUX_FIXED_INLINE void FVec2Array::Reserve(size_t capacity) {
+  x_.reserve(capacity);
+  y_.reserve(capacity);
+}
+
+DUX_FIXED_INLINE void FVec2Array::Clear() {
+  x_.clear();
+  y_.clear();
+}
+
+DUX_FIXED_INLINE void FVec2Array::PushBack(FVec2 const& v) {
+  x_.push_back(v.x_.raw_value_);
+  y_.push_back(v.y_.raw_value_);
+}
+
+DUX_FIXED_INLINE void FVec2Array::SquareLength(FInt* out) const {
+  batch::RawType* raw_out = internal::RawValues(out);
+  batch::RawType y_squared[internal::kBlockSize];
+  for (size_t begin = 0; begin < Size(); begin += internal::kBlockSize) {
+    size_t count = std::min(internal::kBlockSize, Size() - begin);
+    batch::RawType const* x = x_.data() + begin;
+    batch::RawType const* y = y_.data() + begin;
+    batch::Mul(x, x, raw_out + begin, count);
+    batch::Mul(y, y, y_squared, count);
+    batch::Add(raw_out + begin, y_squared, raw_out + begin, count);
+  }
+}
+
+DUX_FIXED_INLINE void FVec2Array::Length(FInt* out) const {
+  for (size_t begin = 0; begin < Size(); begin += internal::kBlockSize) {
+    size_t count = std::min(internal::kBlockSize, Size() - begin);
+    internal::BlockLength(x_.data() + begin, y_.data() + begin, count,
+                          out + begin);
+  }
+}
+
+DUX_FIXED_INLINE void FVec2Array::Normalize(bool* success) {
+  for (size_t i = 0; i < Size(); i++) {
+    FInt components[] = {FInt::FromRawValue(x_[i]),
+                          FInt::FromRawValue(y_[i])};
+    bool normalized = NormalizeComponents(components, 1_fx);
+    if (success) {
+      success[i] = normalized;
+    }
+    x_[i] = components[0].raw_value_;
+    y_[i] = components[1].raw_value_;
+  }
+}
+
+DUX_FIXED_INLINE void FVec2Array::NormalizeWithDivision(bool* success) {
+  FInt length[internal::kBlockSize];
+  for (size_t begin = 0; begin < Size(); begin += internal::kBlockSize) {
+    size_t count = std::min(internal::kBlockSize, Size() - begin);
+    batch::RawType* x = x_.data() + begin;
+    batch::RawType* y = y_.data() + begin;
+    internal::BlockLength(x, y, count, length);
+    for (size_t i = 0; i < count; i++) {
+      bool normalized = length[i].raw_value_ != 0;
+      if (success) {
+        success[begin + i] = normalized;
+      }
+      // Null vectors are left untouched by |FVec2::Normalize|. Dividing 0 by
+      // 1 leaves them untouched too.
+      if (!normalized) {
+        length[i] = 1_fx;
+      }
+    }
+    batch::Div(x, internal::RawValues(length), x, count);
+    batch::Div(y, internal::RawValues(length), y, count);
+  }
+}
+
+DUX_FIXED_INLINE void FVec2Array::DotProduct(FVec2Array const& other,
+                                             FInt* out) const {
+  assert(other.Size() == Size());
+  batch::RawType* raw_out = internal::RawValues(out);
+  batch::RawType y_product[internal::kBlockSize];
+  for (size_t begin = 0; begin < Size(); begin += internal::kBlockSize) {
+    size_t count = std::min(internal::kBlockSize, Size() - begin);
+    batch::Mul(x_.data() + begin, other.x_.data() + begin, raw_out + begin,
+               count);
+    batch::Mul(y_.data() + begin, other.y_.data() + begin, y_product, count);
+    batch::Add(raw_out + begin, y_product, raw_out + begin, count);
+  }
+}
+
+DUX_FIXED_INLINE void FVec2Array::Rotate(FInt angle) {
+  FInt sinn;
+  FInt coss;
+  trig::Sincos(angle, sinn, coss);
+  batch::RawType x_cos[internal::kBlockSize];
+  batch::RawType y_sin[internal::kBlockSize];
+  batch::RawType x_sin[internal::kBlockSize];
+  batch::RawType y_cos[internal::kBlockSize];
+  for (size_t begin = 0; begin < Size(); begin += internal::kBlockSize) {
+    size_t count = std::min(internal::kBlockSize, Size() - begin);
+    batch::RawType* x = x_.data() + begin;
+    batch::RawType* y = y_.data() + begin;
+    batch::MulFInt(x, coss, x_cos, count);
+    batch::MulFInt(y, sinn, y_sin, count);
+    batch::MulFInt(x, sinn, x_sin, count);
+    batch::MulFInt(y, coss, y_cos, count);
+    batch::Sub(x_cos, y_sin, x, count);
+    batch::Add(x_sin, y_cos, y, count);
+  }
+}
+
+DUX_FIXED_INLINE void FVec2Array::Integrate(FVec2Array const& velocity,
+                                            FInt dt) {
+  assert(velocity.Size() == Size());
+  batch::RawType delta[internal::kBlockSize];
+  for (size_t begin = 0; begin < Size(); begin += internal::kBlockSize) {
+    size_t count = std::min(internal::kBlockSize, Size() - begin);
+    batch::MulFInt(velocity.x_.data() + begin, dt, delta, count);
+    batch::Add(x_.data() + begin, delta, x_.data() + begin, count);
+    batch::MulFInt(velocity.y_.data() + begin, dt, delta, count);
+    batch::Add(y_.data() + begin, delta, y_.data() + begin, count);
+  }
+}
+
+}  // namespace dux
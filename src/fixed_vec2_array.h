@@ -0,0 +1,78 @@
+#ifndef DUX_FIXED_SRC_FIXED_VEC2_ARRAY_H_
+#define DUX_FIXED_SRC_FIXED_VEC2_ARRAY_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "fixed_vec2.h"
+
+namespace dux {
+
+// Array of 2D vectors stored as a structure of arrays: all the x components
+// are contiguous, and so are all the y components.
+//
+// The bulk operations run the |dux::batch| kernels over whole arrays, and give
+// the same results as calling the corresponding |FVec2| method on each
+// vector.
+class FVec2Array {
+ public:
+  // Raw values of the components.
+  std::vector<FInt::RawType> x_;
+  std::vector<FInt::RawType> y_;
+
+  FVec2Array() = default;
+  // Creates an array of |size| null vectors.
+  explicit FVec2Array(size_t size);
+
+  size_t Size() const { return x_.size(); }
+  void Resize(size_t size);
+  void Reserve(size_t capacity);
+  void Clear();
+  void PushBack(FVec2 const& v);
+
+  FVec2 Get(size_t index) const {
+    return FVec2(FInt::FromRawValue(x_[index]), FInt::FromRawValue(y_[index]));
+  }
+  void Set(size_t index, FVec2 const& v) {
+    x_[index] = v.x_.raw_value_;
+    y_[index] = v.y_.raw_value_;
+  }
+
+  // Stores the |FVec2::SquareLength| of every vector in |out|, which must have
+  // room for |Size()| values.
+  void SquareLength(FInt* out) const;
+
+  // Stores the |FVec2::Length| of every vector in |out|, which must have room
+  // for |Size()| values.
+  void Length(FInt* out) const;
+
+  // Calls |FVec2::Normalize| on every vector.
+  // If |success| is not null, it must have room for |Size()| values, and
+  // receives the success of each normalization.
+  void Normalize(bool* success);
+
+  // Calls |FVec2::NormalizeWithDivision| on every vector, with |success| like
+  // |Normalize|.
+  void NormalizeWithDivision(bool* success);
+
+  // Stores the |FVec2::DotProduct| of every vector with the vector of same
+  // index in |other| in |out|, which must have room for |Size()| values.
+  // |other| must have the same size as this array.
+  void DotProduct(FVec2Array const& other, FInt* out) const;
+
+  // Calls |FVec2::Rotate| with |angle| on every vector.
+  void Rotate(FInt angle);
+
+  // Adds |velocity| * |dt| to every vector, e.g. to move positions by their
+  // velocity over a tick.
+  // |velocity| must have the same size as this array.
+  void Integrate(FVec2Array const& velocity, FInt dt);
+};
+
+}  // namespace dux
+
+#if defined(DUX_FIXED_HEADER_ONLY)
+#include "fixed_vec2_array.cpp"
+#endif
+
+#endif  // DUX_FIXED_SRC_FIXED_VEC2_ARRAY_H_
@@ -11,40 +11,101 @@ class FVec3 {
   FInt y_;
   FInt z_;
 
-  FVec3() = default;
-  FVec3(FVec3 const& v) = default;
-  FVec3(FInt x, FInt y, FInt z);
-  FVec3(int x, int y, int z);
+  constexpr FVec3() = default;
+  constexpr FVec3(FVec3 const& v) = default;
+  constexpr FVec3(FInt x, FInt y, FInt z) : x_(x), y_(y), z_(z) {}
+  constexpr FVec3(int x, int y, int z)
+      : x_(FInt::FromInt(x)), y_(FInt::FromInt(y)), z_(FInt::FromInt(z)) {}
 
-  void Init(FInt x, FInt y, FInt z);
+  constexpr void Init(FInt x, FInt y, FInt z) {
+    x_ = x;
+    y_ = y;
+    z_ = z;
+  }
 
-  FInt SquareLength() const;
-  FInt SquareLengthFrom(FVec3 const&) const;
+  constexpr FInt SquareLength() const { return x_ * x_ + y_ * y_ + z_ * z_; }
+  constexpr FInt SquareLengthFrom(FVec3 const& c) const {
+    FInt dx = c.x_ - x_;
+    FInt dy = c.y_ - y_;
+    FInt dz = c.z_ - z_;
+    return dx * dx + dy * dy + dz * dz;
+  }
   FInt Length();
+  // Scales the vector to a length of 1 (or |newLength|) with one
+  // |ScaledInverseSqrt| and a multiplication per component: see
+  // |NormalizeComponents| for the precision.
+  // |success| is set to false, and the vector left untouched, if it is null.
   void Normalize(bool& success);
   void Normalize(bool& success, FInt newLength);
+  // Returns the vector scaled to a length of 1, or the null vector if it is
+  // null.
+  [[nodiscard]] FVec3 Normalized() const;
+  // The former |Normalize|, which divides the components by |Length()|. Kept
+  // for the code depending on its exact results.
+  void NormalizeWithDivision(bool& success);
+  void NormalizeWithDivision(bool& success, FInt newLength);
 
-  FVec3 operator+(const FVec3&) const;
-  FVec3 operator-(const FVec3&) const;
-  FInt operator*(const FVec3&) const;
-  FVec3 operator-() const;
-  FVec3 operator*(FInt) const;
+  constexpr FVec3 operator+(const FVec3& a) const {
+    return FVec3(x_ + a.x_, y_ + a.y_, z_ + a.z_);
+  }
+  constexpr FVec3 operator-(const FVec3& a) const {
+    return FVec3(x_ - a.x_, y_ - a.y_, z_ - a.z_);
+  }
+  constexpr FInt operator*(const FVec3& a) const {
+    return (x_ * a.x_ + y_ * a.y_ + z_ * a.z_);
+  }
+  constexpr FVec3 operator-() const { return FVec3(-x_, -y_, -z_); }
+  constexpr FVec3 operator*(FInt v) const {
+    return FVec3(x_ * v, y_ * v, z_ * v);
+  }
 
-  void operator+=(const FVec3&);
-  void operator-=(const FVec3&);
-  void operator*=(FInt);
+  constexpr void operator+=(const FVec3& a) {
+    x_ += a.x_;
+    y_ += a.y_;
+    z_ += a.z_;
+  }
+  constexpr void operator-=(const FVec3& a) {
+    x_ -= a.x_;
+    y_ -= a.y_;
+    z_ -= a.z_;
+  }
+  constexpr void operator*=(FInt v) {
+    x_ *= v;
+    y_ *= v;
+    z_ *= v;
+  }
 
-  FVec3 operator*(const int32_t s) const;
-  FVec3 operator/(const int32_t s) const;
-  void operator*=(const int32_t s);
-  void operator/=(const int32_t s);
+  constexpr FVec3 operator*(const int32_t s) const {
+    return FVec3(x_ * s, y_ * s, z_ * s);
+  }
+  constexpr FVec3 operator/(const int32_t s) const {
+    return FVec3(x_ / s, y_ / s, z_ / s);
+  }
+  constexpr void operator*=(const int32_t s) {
+    x_ *= s;
+    y_ *= s;
+    z_ *= s;
+  }
+  constexpr void operator/=(const int32_t s) {
+    x_ /= s;
+    y_ /= s;
+    z_ /= s;
+  }
 
-  bool operator==(const FVec3&) const;
-  bool operator!=(const FVec3&) const;
+  constexpr bool operator==(const FVec3& other) const {
+    return x_ == other.x_ && y_ == other.y_ && z_ == other.z_;
+  }
+  constexpr bool operator!=(const FVec3& other) const {
+    return x_ != other.x_ || y_ != other.y_ || z_ != other.z_;
+  }
 };
 
 }  // namespace dux
 
 std::ostream& operator<<(std::ostream& stream, const dux::FVec3& fvec3);
 
+#if defined(DUX_FIXED_HEADER_ONLY)
+#include "fixed_vec3.cpp"
+#endif
+
 #endif  // DUX_FILED_SRC_FIXED_VEC3_H_
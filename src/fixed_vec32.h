@@ -0,0 +1,93 @@
+#ifndef DUX_FIXED_SRC_FIXED_VEC32_H_
+#define DUX_FIXED_SRC_FIXED_VEC32_H_
+
+#include "fixed_int.h"
+#include "fixed_vec2.h"
+#include "fixed_vec3.h"
+
+namespace dux {
+
+// Storage counterpart of |FVec2| using |FInt32| components: half the memory,
+// for components in [FInt32Min, FInt32Max].
+// Widen it to a |FVec2| to do computations.
+class FVec2_32 {
+ public:
+  FInt32 x_;
+  FInt32 y_;
+
+  constexpr FVec2_32() = default;
+  constexpr FVec2_32(FInt32 x, FInt32 y) : x_(x), y_(y) {}
+
+  // Returns the vector as a |FVec2|. Never loses precision.
+  [[nodiscard]] constexpr FVec2 Widen() const {
+    return FVec2(dux::Widen(x_), dux::Widen(y_));
+  }
+
+  // Returns |v| with its components clamped to [FInt32Min, FInt32Max].
+  [[nodiscard]] static constexpr FVec2_32 NarrowSaturated(FVec2 const& v) {
+    return FVec2_32(dux::NarrowSaturated(v.x_), dux::NarrowSaturated(v.y_));
+  }
+
+  // Returns |v| as a |FVec2_32|.
+  // |success| is set to false if a component does not fit, in which case the
+  // components are clamped like |NarrowSaturated|.
+  [[nodiscard]] static constexpr FVec2_32 Narrow(FVec2 const& v,
+                                                 bool& success) {
+    success = FitsInFInt32(v.x_) && FitsInFInt32(v.y_);
+    return NarrowSaturated(v);
+  }
+
+  constexpr bool operator==(const FVec2_32& other) const {
+    return x_ == other.x_ && y_ == other.y_;
+  }
+  constexpr bool operator!=(const FVec2_32& other) const {
+    return x_ != other.x_ || y_ != other.y_;
+  }
+};
+
+// Storage counterpart of |FVec3| using |FInt32| components: half the memory,
+// for components in [FInt32Min, FInt32Max].
+// Widen it to a |FVec3| to do computations.
+class FVec3_32 {
+ public:
+  FInt32 x_;
+  FInt32 y_;
+  FInt32 z_;
+
+  constexpr FVec3_32() = default;
+  constexpr FVec3_32(FInt32 x, FInt32 y, FInt32 z) : x_(x), y_(y), z_(z) {}
+
+  // Returns the vector as a |FVec3|. Never loses precision.
+  [[nodiscard]] constexpr FVec3 Widen() const {
+    return FVec3(dux::Widen(x_), dux::Widen(y_), dux::Widen(z_));
+  }
+
+  // Returns |v| with its components clamped to [FInt32Min, FInt32Max].
+  [[nodiscard]] static constexpr FVec3_32 NarrowSaturated(FVec3 const& v) {
+    return FVec3_32(dux::NarrowSaturated(v.x_), dux::NarrowSaturated(v.y_),
+                    dux::NarrowSaturated(v.z_));
+  }
+
+  // Returns |v| as a |FVec3_32|.
+  // |success| is set to false if a component does not fit, in which case the
+  // components are clamped like |NarrowSaturated|.
+  [[nodiscard]] static constexpr FVec3_32 Narrow(FVec3 const& v,
+                                                 bool& success) {
+    success = FitsInFInt32(v.x_) && FitsInFInt32(v.y_) && FitsInFInt32(v.z_);
+    return NarrowSaturated(v);
+  }
+
+  constexpr bool operator==(const FVec3_32& other) const {
+    return x_ == other.x_ && y_ == other.y_ && z_ == other.z_;
+  }
+  constexpr bool operator!=(const FVec3_32& other) const {
+    return !(*this == other);
+  }
+};
+
+static_assert(sizeof(FVec2_32) == 8);
+static_assert(sizeof(FVec3_32) == 12);
+
+}  // namespace dux
+
+#endif  // DUX_FIXED_SRC_FIXED_VEC32_H_
@@ -2,120 +2,278 @@
 
 #include <algorithm>
 
-namespace {
+#include "parallel_for.h"
+
+namespace dux::internal {
 
 constexpr int kGridShift = 6;
 
-inline void AddToVector(std::vector<dux::GridPosition>& vec,
-                        dux::GridPosition const& value,
-                        dux::GridSize const& grid_size) {
-  if (value.x_ < 0 || value.y_ < 0 || value.x_ >= grid_size.width_ ||
-      value.y_ >= grid_size.height_) {
-    return;
+// Returns the maximum number of positions returned by |Walk|: the line has
+// at most one position per column and row of the grid it crosses.
+DUX_FIXED_INLINE size_t MaxWalkSize(dux::FVec2 start,
+                                    dux::FVec2 end,
+                                    dux::GridSpec const& spec) {
+  dux::GridPosition grid_start = spec.PositionOf(start);
+  dux::GridPosition grid_end = spec.PositionOf(end);
+  int64_t max_size =
+      std::min(std::abs(int64_t(grid_end.x_) - grid_start.x_) +
+                   std::abs(int64_t(grid_end.y_) - grid_start.y_) + 1,
+               int64_t(spec.Size().width_) + spec.Size().height_);
+  return static_cast<size_t>(std::max(max_size, int64_t(0)));
+}
+
+// Returns t such that |point| = |start| + (|end| - |start|) * t, computed
+// along the axis on which the line is the longest.
+DUX_FIXED_INLINE dux::FInt LineParameter(dux::FVec2 start,
+                                         dux::FVec2 end,
+                                         dux::FVec2 point) {
+  dux::FVec2 delta = end - start;
+  if (std::abs(delta.x_.raw_value_) >= std::abs(delta.y_.raw_value_)) {
+    return (point.x_ - start.x_).DivWide(delta.x_);
   }
-  vec.push_back(value);
+  return (point.y_ - start.y_).DivWide(delta.y_);
 }
 
-std::vector<dux::GridPosition> AxisAlignedWalk(dux::GridPosition start,
-                                               dux::GridPosition end,
-                                               dux::GridSize const& grid_size) {
-  std::vector<dux::GridPosition> positions;
-  if (start.x_ != end.x_) {
-    int32_t dx = end.x_ > start.x_ ? 1 : -1;
-    AddToVector(positions, start, grid_size);
-    while (start != end) {
-      start.x_ += dx;
-      AddToVector(positions, start, grid_size);
-    }
+DUX_FIXED_INLINE RaycastHit AxisAlignedHit(dux::FVec2 start,
+                                           dux::FVec2 end,
+                                           GridSpec const& spec,
+                                           GridPosition position,
+                                           GridPosition step) {
+  // The line stays in one row or column, so the products are smaller than
+  // |delta| * |spec.CellSize()|.
+  dux::FVec2 delta = end - start;
+  dux::FVec2 corner = spec.CornerOf(position);
+  dux::FVec2 point;
+  if (step.x_ != 0) {
+    point.x_ = step.x_ > 0 ? corner.x_ : corner.x_ + spec.CellSize();
+    point.y_ = start.y_ +
+               delta.y_.MulWide(point.x_ - start.x_).DivWide(delta.x_);
   } else {
-    int32_t dy = end.y_ > start.y_ ? 1 : -1;
-    AddToVector(positions, start, grid_size);
-    while (start != end) {
-      start.y_ += dy;
-      AddToVector(positions, start, grid_size);
-    }
+    point.y_ = step.y_ > 0 ? corner.y_ : corner.y_ + spec.CellSize();
+    point.x_ = start.x_ +
+               delta.x_.MulWide(point.y_ - start.y_).DivWide(delta.y_);
+  }
+  return {position, point, LineParameter(start, end, point)};
+}
+
+DUX_FIXED_INLINE RaycastHit DiagonalHit(dux::FVec2 start,
+                                        dux::FVec2 end,
+                                        GridSpec const& spec,
+                                        DiagonalWalk const& walk,
+                                        GridPosition from,
+                                        dux::FInt error,
+                                        bool x_step,
+                                        GridPosition position) {
+  // The delta of the line walked from left to right.
+  dux::FVec2 delta = walk.reversed_ ? start - end : end - start;
+  dux::FVec2 corner = spec.CornerOf(from);
+  // The corner of |from| towards which the walk goes.
+  dux::FInt border_x = corner.x_ + spec.CellSize();
+  dux::FInt border_y = walk.dy_ > 0 ? corner.y_ + spec.CellSize() : corner.y_;
+  // |error| is delta.x_ * dy_ * (border_y - y), where y is the ordinate of
+  // the line at border_x, and |delta.y_| * (x - border_x), where x is the
+  // abscissa of the line at border_y.
+  dux::FVec2 point;
+  if (x_step) {
+    dux::FInt offset = error.DivWide(delta.x_);
+    point = {border_x, walk.dy_ > 0 ? border_y - offset : border_y + offset};
+  } else {
+    dux::FInt abs_delta_y = walk.dy_ > 0 ? delta.y_ : -delta.y_;
+    point = {border_x + error.DivWide(abs_delta_y), border_y};
   }
-  return positions;
+  return {position, point, LineParameter(start, end, point)};
 }
 
-}  // namespace
+}  // namespace dux::internal
 
 namespace dux {
 
-dux::GridPosition GridPositionFromFVec2(dux::FVec2 v) {
+DUX_FIXED_INLINE dux::GridPosition GridPositionFromFVec2(dux::FVec2 v) {
   dux::GridPosition p;
-  p.x_ =
-      static_cast<int32_t>(v.x_.raw_value_ >> (kGridShift + dux::FInt::kShift));
-  p.y_ =
-      static_cast<int32_t>(v.y_.raw_value_ >> (kGridShift + dux::FInt::kShift));
+  constexpr int kShift = internal::kGridShift + dux::FInt::kShift;
+  p.x_ = static_cast<int32_t>(v.x_.raw_value_ >> kShift);
+  p.y_ = static_cast<int32_t>(v.y_.raw_value_ >> kShift);
   return p;
 }
 
-std::vector<GridPosition> Walk(dux::FVec2 start,
-                               dux::FVec2 end,
-                               GridSize const grid_size) {
-  dux::GridPosition grid_start = GridPositionFromFVec2(start);
-  dux::GridPosition grid_end = GridPositionFromFVec2(end);
-  if (grid_start.x_ == grid_end.x_ || grid_start.y_ == grid_end.y_) {
-    return AxisAlignedWalk(grid_start, grid_end, grid_size);
+DUX_FIXED_INLINE std::vector<GridPosition> Walk(dux::FVec2 start,
+                                                dux::FVec2 end,
+                                                GridSize const grid_size) {
+  return Walk(start, end, GridSpec(grid_size));
+}
+
+DUX_FIXED_INLINE std::vector<GridPosition> Walk(dux::FVec2 start,
+                                                dux::FVec2 end,
+                                                GridSpec const& spec) {
+  std::vector<GridPosition> v;
+  v.reserve(internal::MaxWalkSize(start, end, spec));
+  WalkVisit(start, end, spec, [&v](GridPosition const& position) {
+    v.push_back(position);
+    return true;
+  });
+  return v;
+}
+
+DUX_FIXED_INLINE void WalkMany(dux::FVec2 const* starts,
+                               dux::FVec2 const* ends,
+                               size_t count,
+                               GridSpec const& spec,
+                               WalkBuffer& buffer,
+                               ThreadPool* pool) {
+  // |offsets_[i]| first receives the beginning of the part of the buffer
+  // reserved for the line i.
+  buffer.offsets_.resize(count + 1);
+  size_t max_size = 0;
+  for (size_t i = 0; i < count; i++) {
+    buffer.offsets_[i] = max_size;
+    max_size += internal::MaxWalkSize(starts[i], ends[i], spec);
   }
+  buffer.offsets_[count] = max_size;
+  buffer.positions_.resize(max_size);
 
-  bool swap = false;
+  // The lines of a chunk are written after each other, from the beginning of
+  // the part reserved for its first line.
+  constexpr size_t kChunkSize = 64;
+  buffer.chunk_ends_.resize((count + kChunkSize - 1) / kChunkSize);
+  GridPosition* positions = buffer.positions_.data();
+  size_t* offsets = buffer.offsets_.data();
+  size_t* chunk_ends = buffer.chunk_ends_.data();
+  internal::ParallelFor(
+      count, kChunkSize, pool, [&](size_t begin, size_t end) {
+        size_t size = offsets[begin];
+        for (size_t i = begin; i < end; i++) {
+          offsets[i] = size;
+          WalkVisit(starts[i], ends[i], spec,
+                    [positions, &size](GridPosition const& p) {
+                      positions[size++] = p;
+                      return true;
+                    });
+        }
+        chunk_ends[begin / kChunkSize] = size;
+      });
 
-  if (end < start || (start.x_ > end.x_ && start.y_ < end.y_)) {
-    swap = true;
-    std::swap(start, end);
-    std::swap(grid_start, grid_end);
+  // Moves the chunks next to each other.
+  size_t size = 0;
+  for (size_t chunk = 0; chunk < buffer.chunk_ends_.size(); chunk++) {
+    size_t begin = chunk * kChunkSize;
+    size_t end = std::min(begin + kChunkSize, count);
+    size_t chunk_begin = offsets[begin];
+    size_t chunk_size = chunk_ends[chunk] - chunk_begin;
+    if (chunk_begin != size) {
+      std::copy(positions + chunk_begin, positions + chunk_begin + chunk_size,
+                positions + size);
+      for (size_t i = begin; i < end; i++) {
+        offsets[i] -= chunk_begin - size;
+      }
+    }
+    size += chunk_size;
   }
+  offsets[count] = size;
+  buffer.positions_.resize(size);
+}
 
-  std::vector<GridPosition> v;
+DUX_FIXED_INLINE void WalkMany(dux::FVec2 const* starts,
+                               dux::FVec2 const* ends,
+                               size_t count,
+                               GridSize size,
+                               WalkBuffer& buffer,
+                               ThreadPool* pool) {
+  WalkMany(starts, ends, count, GridSpec(size), buffer, pool);
+}
 
-  int32_t iterations =
-      abs(grid_end.x_ - grid_start.x_) + abs(grid_end.y_ - grid_start.y_);
-  dux::FVec2 delta = end - start;
+DUX_FIXED_INLINE GridWalker::GridWalker(dux::FVec2 start,
+                                        dux::FVec2 end,
+                                        GridSpec const& spec)
+    : size_(spec.Size()),
+      phase_(Phase::kAxisAligned),
+      walk_(),
+      axis_step_({0, 0}),
+      steps_(0),
+      initial_error_(),
+      initial_steps_(0) {
+  GridPosition grid_start = spec.PositionOf(start);
+  GridPosition grid_end = spec.PositionOf(end);
+  if (grid_start.x_ == grid_end.x_ || grid_start.y_ == grid_end.y_) {
+    walk_.position_ = grid_start;
+    walk_.end_ = grid_end;
+    if (grid_start.x_ != grid_end.x_) {
+      axis_step_.x_ = grid_end.x_ > grid_start.x_ ? 1 : -1;
+    } else {
+      axis_step_.y_ = grid_end.y_ > grid_start.y_ ? 1 : -1;
+    }
+    return;
+  }
+  walk_ = internal::StartDiagonalWalk(start, end, spec);
+  phase_ = walk_.reversed_ ? Phase::kPreparing : Phase::kForward;
+  initial_error_ = walk_.error_;
+}
 
-  if (start < end) {
-    // From bottom-left to top-right
-    dux::FInt Δx = 64_fx - start.x_.EuclideanDivisionRemainder(64_fx);
-    dux::FInt Δy = 64_fx - start.y_.EuclideanDivisionRemainder(64_fx);
-    dux::FInt error = delta.x_ * Δy - delta.y_ * Δx;
-    delta *= 64_fx;
-    for (int i = 0; i < iterations; i++) {
-      AddToVector(v, grid_start, grid_size);
-      if (error < 0_fx) {
-        error = error + delta.x_;
-        grid_start.y_++;
+DUX_FIXED_INLINE bool GridWalker::Step(GridPosition& position) {
+  switch (phase_) {
+    case Phase::kAxisAligned:
+      position = walk_.position_;
+      if (walk_.position_ == walk_.end_) {
+        phase_ = Phase::kDone;
       } else {
-        error = error - delta.y_;
-        grid_start.x_++;
+        walk_.position_.x_ += axis_step_.x_;
+        walk_.position_.y_ += axis_step_.y_;
       }
-    }
-    AddToVector(v, grid_end, grid_size);
-  } else {
-    assert(start.x_ < end.x_ && start.y_ > end.y_);
-    // From top-left to bottom-right
-    dux::FInt Δx = 64_fx - (start.x_.EuclideanDivisionRemainder(64_fx));
-    dux::FInt Δy = start.y_.EuclideanDivisionRemainder(64_fx);
-    dux::FInt error = delta.x_ * Δy + delta.y_ * Δx;
-    delta *= 64_fx;
-    for (int i = 0; i < iterations; i++) {
-      AddToVector(v, grid_start, grid_size);
-      if (error < 0_fx) {
-        error = error + delta.x_;
-        grid_start.y_--;
+      return true;
+    case Phase::kForward:
+      if (steps_ < walk_.iterations_) {
+        position = walk_.position_;
+        walk_.Step();
+        steps_++;
+      } else {
+        position = walk_.end_;
+        phase_ = Phase::kDone;
+      }
+      return true;
+    case Phase::kPreparing:
+      if (steps_ < walk_.iterations_) {
+        if (walk_.error_ < -walk_.x_step_error_ ||
+            walk_.error_ >= walk_.y_step_error_) {
+          initial_steps_ = steps_ + 1;
+        }
+        walk_.Step();
+        steps_++;
+        return false;
+      }
+      position = walk_.end_;
+      phase_ = steps_ > 0 ? Phase::kBackward : Phase::kDone;
+      return true;
+    case Phase::kBackward: {
+      steps_--;
+      bool x_step = steps_ < initial_steps_
+                        ? initial_error_ >= 0_fx
+                        : walk_.error_ < walk_.y_step_error_ -
+                                             walk_.x_step_error_;
+      if (x_step) {
+        walk_.error_ = walk_.error_ + walk_.x_step_error_;
+        walk_.position_.x_--;
       } else {
-        error = error + delta.y_;
-        grid_start.x_++;
+        walk_.error_ = walk_.error_ - walk_.y_step_error_;
+        walk_.position_.y_ -= walk_.dy_;
       }
+      position = walk_.position_;
+      if (steps_ == 0) {
+        phase_ = Phase::kDone;
+      }
+      return true;
     }
-    AddToVector(v, grid_end, grid_size);
+    case Phase::kDone:
+      break;
   }
+  return false;
+}
 
-  if (swap) {
-    std::reverse(v.begin(), v.end());
+DUX_FIXED_INLINE bool GridWalker::Next(GridPosition& position) {
+  while (!Done()) {
+    if (Step(position) && IsOnGrid(position)) {
+      return true;
+    }
   }
-
-  return v;
+  return false;
 }
 
 }  // namespace dux
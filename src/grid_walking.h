@@ -1,12 +1,22 @@
 #ifndef DUX_FILED_SRC_GRID_WALKING_H_
 #define DUX_FILED_SRC_GRID_WALKING_H_
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <utility>
 #include <vector>
 
 #include "fixed_vec2.h"
 
 namespace dux {
 
+class ThreadPool;
+
 struct GridSize {
   int32_t width_;
   int32_t height_;
@@ -15,21 +25,685 @@ struct GridSize {
 struct GridPosition {
   int32_t x_;
   int32_t y_;
-  bool operator==(GridPosition const& other) {
+  constexpr bool operator==(GridPosition const& other) const {
     return x_ == other.x_ && y_ == other.y_;
   }
-  bool operator!=(GridPosition const& other) {
+  constexpr bool operator!=(GridPosition const& other) const {
     return x_ != other.x_ || y_ != other.y_;
   }
 };
 
 dux::GridPosition GridPositionFromFVec2(dux::FVec2 v);
 
+// Placement and resolution of a grid: the square (x, y) covers the points p
+// such that |Origin()| + (x, y) * |CellSize()| <= p and
+// p < |Origin()| + (x + 1, y + 1) * |CellSize()|.
+//
+// The squares are found with shifts when the raw value of |CellSize()| is a
+// power of two, and with divisions otherwise.
+class GridSpec {
+ public:
+  // A grid of 64x64 squares starting at (0, 0), whose squares are the ones
+  // of |GridPositionFromFVec2|. The grid is at most 2^31 wide.
+  constexpr explicit GridSpec(GridSize size)
+      : GridSpec(size, 64_fx, dux::FVec2(0_fx, 0_fx)) {}
+  // |cell_size| must be positive.
+  constexpr GridSpec(GridSize size, dux::FInt cell_size, dux::FVec2 origin)
+      : size_(size), cell_size_(cell_size), origin_(origin), cell_shift_(-1) {
+    assert(cell_size.raw_value_ > 0);
+    FInt::RawType raw_cell_size = cell_size.raw_value_;
+    if ((raw_cell_size & (raw_cell_size - 1)) == 0) {
+      cell_shift_ = 0;
+      while ((FInt::RawType(1) << cell_shift_) != raw_cell_size) {
+        cell_shift_++;
+      }
+    }
+  }
+
+  constexpr GridSize Size() const { return size_; }
+  constexpr dux::FInt CellSize() const { return cell_size_; }
+  constexpr dux::FVec2 Origin() const { return origin_; }
+
+  // Returns the square containing |v|, which may be outside of the grid.
+  // The coordinates beyond the range of |int32_t| are clamped to it, so that
+  // the squares far away stay on the same side of the grid.
+  constexpr GridPosition PositionOf(dux::FVec2 v) const {
+    return {ClampToInt32(FloorDivide(v.x_ - origin_.x_)),
+            ClampToInt32(FloorDivide(v.y_ - origin_.y_))};
+  }
+
+  // Returns the offset of |v| from the corner of the square containing it,
+  // in [0, |CellSize()|[.
+  constexpr dux::FVec2 OffsetInCell(dux::FVec2 v) const {
+    return {Remainder(v.x_ - origin_.x_), Remainder(v.y_ - origin_.y_)};
+  }
+
+  // Returns the corner of the square |p| with the smallest coordinates.
+  constexpr dux::FVec2 CornerOf(GridPosition p) const {
+    return {origin_.x_ + cell_size_ * p.x_, origin_.y_ + cell_size_ * p.y_};
+  }
+
+ private:
+  static constexpr int32_t ClampToInt32(FInt::RawType value) {
+    return static_cast<int32_t>(
+        std::clamp(value,
+                   FInt::RawType(std::numeric_limits<int32_t>::min()),
+                   FInt::RawType(std::numeric_limits<int32_t>::max())));
+  }
+
+  // Returns floor(|offset| / |cell_size_|).
+  constexpr FInt::RawType FloorDivide(dux::FInt offset) const {
+    FInt::RawType raw = offset.raw_value_;
+    if (cell_shift_ >= 0) {
+      return raw >> cell_shift_;
+    }
+    FInt::RawType quotient = raw / cell_size_.raw_value_;
+    return raw % cell_size_.raw_value_ < 0 ? quotient - 1 : quotient;
+  }
+
+  // Returns |offset| - floor(|offset| / |cell_size_|) * |cell_size_|.
+  constexpr dux::FInt Remainder(dux::FInt offset) const {
+    FInt::RawType raw = offset.raw_value_;
+    if (cell_shift_ >= 0) {
+      return FInt::FromRawValue(raw & (cell_size_.raw_value_ - 1));
+    }
+    FInt::RawType remainder = raw % cell_size_.raw_value_;
+    return FInt::FromRawValue(
+        remainder < 0 ? remainder + cell_size_.raw_value_ : remainder);
+  }
+
+  GridSize size_;
+  dux::FInt cell_size_;
+  dux::FVec2 origin_;
+  // Log2 of the raw value of |cell_size_| if it is a power of two, -1
+  // otherwise.
+  int cell_shift_;
+};
+
 // Returns a 4-connected line on a grid where each square is 64x64.
 // Does not return positions outside of (0, 0) x (size.x_ - 1, size.y_ - 1).
-// The grid is at most 2^15 wide.
+// Same as |Walk(start, end, GridSpec(size))|: the lines must be shorter than
+// 2^45, and the grid at most 2^31 wide.
 std::vector<GridPosition> Walk(dux::FVec2 start, dux::FVec2 end, GridSize size);
 
+// Returns a 4-connected line on the grid of |spec|.
+// Does not return positions outside of the grid.
+// The lines must be shorter than 2^51 / |spec.CellSize()| (2^45 for squares
+// of size 64), and the grid at most 2^31 wide.
+std::vector<GridPosition> Walk(dux::FVec2 start,
+                               dux::FVec2 end,
+                               GridSpec const& spec);
+
+// Positions of the lines walked by |WalkMany|, kept by the caller so that
+// the memory is reused by the next calls.
+struct WalkBuffer {
+  // The positions of the line i are the ones of |positions_| between
+  // |offsets_[i]| and |offsets_[i + 1]| excluded.
+  std::vector<GridPosition> positions_;
+  std::vector<size_t> offsets_;
+  // End of the positions written for each chunk of lines by |WalkMany|.
+  std::vector<size_t> chunk_ends_;
+
+  size_t LineCount() const {
+    return offsets_.empty() ? 0 : offsets_.size() - 1;
+  }
+  size_t LineSize(size_t line) const {
+    return offsets_[line + 1] - offsets_[line];
+  }
+  GridPosition const* LineBegin(size_t line) const {
+    return positions_.data() + offsets_[line];
+  }
+  GridPosition const* LineEnd(size_t line) const {
+    return positions_.data() + offsets_[line + 1];
+  }
+};
+
+// Stores the positions returned by |Walk(starts[i], ends[i], spec)| for each
+// of the |count| lines in |buffer|, replacing its previous content.
+// |buffer| is resized once to the maximum number of positions of all the
+// lines, so that the walks do not allocate, and then to the actual number.
+//
+// The lines are walked in chunks of 64 lines by the threads of |pool|,
+// including the calling one, or by the calling thread only if |pool| is
+// null. Each chunk is written to its own part of the buffer, and the parts
+// are then moved next to each other: the content of |buffer| is the same
+// whatever the number of threads.
+// No thread is created: the threads of |pool| are woken up, which costs a
+// few microseconds, unless there are at most 64 lines.
+void WalkMany(dux::FVec2 const* starts,
+              dux::FVec2 const* ends,
+              size_t count,
+              GridSpec const& spec,
+              WalkBuffer& buffer,
+              ThreadPool* pool = nullptr);
+void WalkMany(dux::FVec2 const* starts,
+              dux::FVec2 const* ends,
+              size_t count,
+              GridSize size,
+              WalkBuffer& buffer,
+              ThreadPool* pool = nullptr);
+
+// Calls |visitor| with each of the positions returned by |Walk|, in the same
+// order, without allocating. |visitor| takes a |GridPosition| and returns
+// false to stop the walk.
+// Returns false if |visitor| stopped the walk.
+template <typename Visitor>
+bool WalkVisit(dux::FVec2 start,
+               dux::FVec2 end,
+               GridSpec const& spec,
+               Visitor&& visitor);
+template <typename Visitor>
+bool WalkVisit(dux::FVec2 start,
+               dux::FVec2 end,
+               GridSize size,
+               Visitor&& visitor) {
+  return WalkVisit(start, end, GridSpec(size), visitor);
+}
+
+// First square of a line that is blocked, see |RaycastFirst|.
+struct RaycastHit {
+  GridPosition position_;
+  // Point where the line enters |position_|, on its border, or the start of
+  // the line if it starts in |position_|.
+  dux::FVec2 point_;
+  // Position of |point_| along the line: |point_| is start + (end - start) *
+  // |t_|, up to the rounding of |t_|.
+  dux::FInt t_;
+};
+
+// Returns the first of the positions returned by |Walk| for which
+// |is_blocked(position)| returns true, and where the line enters it, or
+// std::nullopt if there is none. The positions after it are not walked.
+// The entry point is computed from the error term of the walk at the step
+// entering the square, so the lines have the same limits as for |Walk|.
+template <typename IsBlocked>
+std::optional<RaycastHit> RaycastFirst(dux::FVec2 start,
+                                       dux::FVec2 end,
+                                       GridSpec const& spec,
+                                       IsBlocked&& is_blocked);
+template <typename IsBlocked>
+std::optional<RaycastHit> RaycastFirst(dux::FVec2 start,
+                                       dux::FVec2 end,
+                                       GridSize size,
+                                       IsBlocked&& is_blocked) {
+  return RaycastFirst(start, end, GridSpec(size), is_blocked);
+}
+
+namespace internal {
+
+// Calls |visitor| with |position| if it is on the grid.
+// Returns false if |visitor| did.
+template <typename Visitor>
+bool VisitGridPosition(GridPosition const& position,
+                       GridSize const& size,
+                       Visitor& visitor) {
+  if (position.x_ < 0 || position.y_ < 0 || position.x_ >= size.width_ ||
+      position.y_ >= size.height_) {
+    return true;
+  }
+  return visitor(position);
+}
+
+template <typename Visitor>
+bool AxisAlignedWalkVisit(GridPosition start,
+                          GridPosition end,
+                          GridSize const& size,
+                          Visitor& visitor) {
+  GridPosition step = {0, 0};
+  if (start.x_ != end.x_) {
+    step.x_ = end.x_ > start.x_ ? 1 : -1;
+  } else {
+    step.y_ = end.y_ > start.y_ ? 1 : -1;
+  }
+  if (!VisitGridPosition(start, size, visitor)) {
+    return false;
+  }
+  while (start != end) {
+    start.x_ += step.x_;
+    start.y_ += step.y_;
+    if (!VisitGridPosition(start, size, visitor)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The walk of a line that is not axis-aligned, from its left end, so that
+// walking in both directions visits the same positions.
+// The positions are |position_| before each of the |iterations_| steps, then
+// |end_|.
+struct DiagonalWalk {
+  GridPosition position_;
+  GridPosition end_;
+  int64_t iterations_;
+  // Each step moves along y if |error_| is negative, adding |y_step_error_|
+  // to it, and along x otherwise, subtracting |x_step_error_| from it.
+  dux::FInt error_;
+  dux::FInt y_step_error_;
+  dux::FInt x_step_error_;
+  int32_t dy_;
+  // True if the line goes from right to left.
+  bool reversed_;
+
+  // Returns true if the step moved along y.
+  bool Step() {
+    if (error_ < 0_fx) {
+      error_ = error_ + y_step_error_;
+      position_.y_ += dy_;
+      return true;
+    }
+    error_ = error_ - x_step_error_;
+    position_.x_++;
+    return false;
+  }
+};
+
+// |start| and |end| must not be on the same row or column of the grid.
+// The products use |MulWide|, which gives the same results as |operator*|
+// when it does not overflow, so that long lines can be walked.
+inline DiagonalWalk StartDiagonalWalk(dux::FVec2 start,
+                                      dux::FVec2 end,
+                                      GridSpec const& spec) {
+  DiagonalWalk walk;
+  walk.reversed_ = false;
+  if (end < start || (start.x_ > end.x_ && start.y_ < end.y_)) {
+    walk.reversed_ = true;
+    std::swap(start, end);
+  }
+  walk.position_ = spec.PositionOf(start);
+  walk.end_ = spec.PositionOf(end);
+  walk.iterations_ =
+      std::abs(int64_t(walk.end_.x_) - walk.position_.x_) +
+      std::abs(int64_t(walk.end_.y_) - walk.position_.y_);
+  dux::FVec2 delta = end - start;
+  dux::FInt cell_size = spec.CellSize();
+  dux::FVec2 offset = spec.OffsetInCell(start);
+  if (start < end) {
+    // From bottom-left to top-right
+    dux::FInt Δx = cell_size - offset.x_;
+    dux::FInt Δy = cell_size - offset.y_;
+    walk.error_ = delta.x_.MulWide(Δy) - delta.y_.MulWide(Δx);
+    walk.y_step_error_ = delta.x_.MulWide(cell_size);
+    walk.x_step_error_ = delta.y_.MulWide(cell_size);
+    walk.dy_ = 1;
+  } else {
+    assert(start.x_ < end.x_ && start.y_ > end.y_);
+    // From top-left to bottom-right
+    dux::FInt Δx = cell_size - offset.x_;
+    dux::FInt Δy = offset.y_;
+    walk.error_ = delta.x_.MulWide(Δy) + delta.y_.MulWide(Δx);
+    walk.y_step_error_ = delta.x_.MulWide(cell_size);
+    walk.x_step_error_ = -delta.y_.MulWide(cell_size);
+    walk.dy_ = -1;
+  }
+  return walk;
+}
+
+// Calls |visitor(y, x_begin, x_end)| with the squares of the grid returned
+// by |Walk|, grouped in runs of squares of the row |y| between the columns
+// |x_begin| and |x_end| excluded. The runs are not visited in the order of
+// |Walk|, and may contain a square twice.
+// Returns false if |visitor| stopped the walk.
+template <typename Visitor>
+bool WalkRows(dux::FVec2 start,
+              dux::FVec2 end,
+              GridSpec const& spec,
+              Visitor& visitor);
+
+}  // namespace internal
+
+// Walk of a line that produces the positions returned by |Walk| one at a
+// time, in the same order, so that a long line can be walked over several
+// ticks without redoing its setup:
+//
+//   GridWalker walker(start, end, size);
+//   // During each tick, until |Resume| returns true:
+//   walker.Resume(1000, [](GridPosition p) { ...; return true; });
+//
+// The remaining positions can also be iterated with a range-based for loop.
+// Leaving the loop early keeps the walker at the next position.
+class GridWalker {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = GridPosition;
+    using difference_type = std::ptrdiff_t;
+    using pointer = GridPosition const*;
+    using reference = GridPosition const&;
+
+    explicit Iterator(GridWalker* walker) : walker_(walker), position_() {}
+
+    GridPosition const& operator*() const { return position_; }
+    Iterator& operator++() {
+      if (!walker_->Next(position_)) {
+        walker_ = nullptr;
+      }
+      return *this;
+    }
+    bool operator==(Iterator const& other) const {
+      return walker_ == other.walker_;
+    }
+    bool operator!=(Iterator const& other) const {
+      return walker_ != other.walker_;
+    }
+
+   private:
+    // Null at the end of the walk.
+    GridWalker* walker_;
+    GridPosition position_;
+  };
+
+  GridWalker(dux::FVec2 start, dux::FVec2 end, GridSpec const& spec);
+  GridWalker(dux::FVec2 start, dux::FVec2 end, GridSize size)
+      : GridWalker(start, end, GridSpec(size)) {}
+
+  // Returns true once all the positions have been produced.
+  bool Done() const { return phase_ == Phase::kDone; }
+
+  // Stores the next position in |position|.
+  // Returns false if all the positions have already been produced.
+  bool Next(GridPosition& position);
+
+  // Calls |visitor| with the next positions, like |WalkVisit|, and pauses
+  // after |budget| steps, or when |visitor| returns false.
+  // The steps include the positions outside of the grid, which are skipped,
+  // and for the lines going from right to left, a first pass finding the
+  // end of the line, which is then walked backwards (see |WalkVisit|).
+  // Returns true if the walk is done.
+  template <typename Visitor>
+  bool Resume(int64_t budget, Visitor&& visitor);
+
+  Iterator begin() {
+    Iterator it(this);
+    return ++it;
+  }
+  Iterator end() { return Iterator(nullptr); }
+
+ private:
+  enum class Phase {
+    kAxisAligned,
+    kForward,
+    // The first pass over the lines going from right to left.
+    kPreparing,
+    kBackward,
+    kDone,
+  };
+
+  // Does one step of the walk.
+  // Returns true if it produced a position, stored in |position|, which may
+  // be outside of the grid.
+  bool Step(GridPosition& position);
+
+  bool IsOnGrid(GridPosition const& position) const {
+    return position.x_ >= 0 && position.y_ >= 0 &&
+           position.x_ < size_.width_ && position.y_ < size_.height_;
+  }
+
+  GridSize size_;
+  Phase phase_;
+  // Only |position_| and |end_| are used by the axis-aligned lines.
+  internal::DiagonalWalk walk_;
+  // Step between the positions of the axis-aligned lines.
+  GridPosition axis_step_;
+  // Number of steps of |walk_| done, or left to undo when walking backwards.
+  int64_t steps_;
+  // State of the backward walk, see |WalkVisit|.
+  dux::FInt initial_error_;
+  int64_t initial_steps_;
+};
+
+template <typename Visitor>
+bool GridWalker::Resume(int64_t budget, Visitor&& visitor) {
+  for (int64_t i = 0; i < budget && !Done(); i++) {
+    GridPosition position;
+    if (Step(position) && IsOnGrid(position) && !visitor(position)) {
+      break;
+    }
+  }
+  return Done();
+}
+
+template <typename Visitor>
+bool WalkVisit(dux::FVec2 start,
+               dux::FVec2 end,
+               GridSpec const& spec,
+               Visitor&& visitor) {
+  GridSize size = spec.Size();
+  dux::GridPosition grid_start = spec.PositionOf(start);
+  dux::GridPosition grid_end = spec.PositionOf(end);
+  if (grid_start.x_ == grid_end.x_ || grid_start.y_ == grid_end.y_) {
+    return internal::AxisAlignedWalkVisit(grid_start, grid_end, size, visitor);
+  }
+
+  internal::DiagonalWalk walk = internal::StartDiagonalWalk(start, end, spec);
+  if (!walk.reversed_) {
+    for (int64_t i = 0; i < walk.iterations_; i++) {
+      if (!internal::VisitGridPosition(walk.position_, size, visitor)) {
+        return false;
+      }
+      walk.Step();
+    }
+    return internal::VisitGridPosition(walk.end_, size, visitor);
+  }
+
+  // Walks the steps backwards from the position reached after the last one.
+  // Once |error_| is in [-x_step_error_, y_step_error_[, the steps keep it in
+  // that range, and only one of the two possible previous values of |error_|
+  // is in it. The steps before, if any, all go in the direction given by the
+  // sign of the initial |error_|.
+  dux::FInt initial_error = walk.error_;
+  int64_t initial_steps = 0;
+  for (int64_t i = 0; i < walk.iterations_; i++) {
+    if (walk.error_ < -walk.x_step_error_ ||
+        walk.error_ >= walk.y_step_error_) {
+      initial_steps = i + 1;
+    }
+    walk.Step();
+  }
+  if (!internal::VisitGridPosition(walk.end_, size, visitor)) {
+    return false;
+  }
+  dux::FInt x_step_limit = walk.y_step_error_ - walk.x_step_error_;
+  for (int64_t i = walk.iterations_ - 1; i >= 0; i--) {
+    bool x_step =
+        i < initial_steps ? initial_error >= 0_fx : walk.error_ < x_step_limit;
+    if (x_step) {
+      walk.error_ = walk.error_ + walk.x_step_error_;
+      walk.position_.x_--;
+    } else {
+      walk.error_ = walk.error_ - walk.y_step_error_;
+      walk.position_.y_ -= walk.dy_;
+    }
+    if (!internal::VisitGridPosition(walk.position_, size, visitor)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+namespace internal {
+
+// Returns true if |position| is on the grid and |is_blocked(position)|.
+template <typename IsBlocked>
+bool IsBlockedOnGrid(GridPosition const& position,
+                     GridSize const& size,
+                     IsBlocked& is_blocked) {
+  return position.x_ >= 0 && position.y_ >= 0 &&
+         position.x_ < size.width_ && position.y_ < size.height_ &&
+         is_blocked(position);
+}
+
+// Returns the hit of a line entering |position| from the square before it
+// along |step|, for lines whose start and end are on the same row or column
+// of the grid.
+RaycastHit AxisAlignedHit(dux::FVec2 start,
+                          dux::FVec2 end,
+                          GridSpec const& spec,
+                          GridPosition position,
+                          GridPosition step);
+
+// Returns the hit of the line of |walk| entering |position| through the
+// border crossed by a step of |walk| from |from|, which moves along x if
+// |x_step| is true, and starts with |error| as |walk.error_|. For the lines
+// going from right to left, |from| is |position|.
+RaycastHit DiagonalHit(dux::FVec2 start,
+                       dux::FVec2 end,
+                       GridSpec const& spec,
+                       DiagonalWalk const& walk,
+                       GridPosition from,
+                       dux::FInt error,
+                       bool x_step,
+                       GridPosition position);
+
+}  // namespace internal
+
+template <typename IsBlocked>
+std::optional<RaycastHit> RaycastFirst(dux::FVec2 start,
+                                       dux::FVec2 end,
+                                       GridSpec const& spec,
+                                       IsBlocked&& is_blocked) {
+  GridSize size = spec.Size();
+  dux::GridPosition grid_start = spec.PositionOf(start);
+  dux::GridPosition grid_end = spec.PositionOf(end);
+  if (internal::IsBlockedOnGrid(grid_start, size, is_blocked)) {
+    return RaycastHit{grid_start, start, 0_fx};
+  }
+  if (grid_start.x_ == grid_end.x_ || grid_start.y_ == grid_end.y_) {
+    GridPosition step = {0, 0};
+    if (grid_start.x_ != grid_end.x_) {
+      step.x_ = grid_end.x_ > grid_start.x_ ? 1 : -1;
+    } else {
+      step.y_ = grid_end.y_ > grid_start.y_ ? 1 : -1;
+    }
+    GridPosition position = grid_start;
+    while (position != grid_end) {
+      position.x_ += step.x_;
+      position.y_ += step.y_;
+      if (internal::IsBlockedOnGrid(position, size, is_blocked)) {
+        return internal::AxisAlignedHit(start, end, spec, position, step);
+      }
+    }
+    return std::nullopt;
+  }
+
+  // Same walks as |WalkVisit|, which keep the state of the step entering
+  // each position.
+  internal::DiagonalWalk walk = internal::StartDiagonalWalk(start, end, spec);
+  if (!walk.reversed_) {
+    for (int64_t i = 0; i < walk.iterations_; i++) {
+      GridPosition from = walk.position_;
+      dux::FInt error = walk.error_;
+      bool x_step = !walk.Step();
+      GridPosition position =
+          i + 1 < walk.iterations_ ? walk.position_ : walk.end_;
+      if (internal::IsBlockedOnGrid(position, size, is_blocked)) {
+        return internal::DiagonalHit(start, end, spec, walk, from, error,
+                                     x_step, position);
+      }
+    }
+    return std::nullopt;
+  }
+
+  dux::FInt initial_error = walk.error_;
+  int64_t initial_steps = 0;
+  for (int64_t i = 0; i < walk.iterations_; i++) {
+    if (walk.error_ < -walk.x_step_error_ ||
+        walk.error_ >= walk.y_step_error_) {
+      initial_steps = i + 1;
+    }
+    walk.Step();
+  }
+  dux::FInt x_step_limit = walk.y_step_error_ - walk.x_step_error_;
+  for (int64_t i = walk.iterations_ - 1; i >= 0; i--) {
+    bool x_step =
+        i < initial_steps ? initial_error >= 0_fx : walk.error_ < x_step_limit;
+    if (x_step) {
+      walk.error_ = walk.error_ + walk.x_step_error_;
+      walk.position_.x_--;
+    } else {
+      walk.error_ = walk.error_ - walk.y_step_error_;
+      walk.position_.y_ -= walk.dy_;
+    }
+    // The line enters |walk.position_| through the border crossed by the
+    // step undone.
+    if (internal::IsBlockedOnGrid(walk.position_, size, is_blocked)) {
+      return internal::DiagonalHit(start, end, spec, walk, walk.position_,
+                                   walk.error_, x_step, walk.position_);
+    }
+  }
+  return std::nullopt;
+}
+
+namespace internal {
+
+// Calls |visitor| with the squares of the row |y| between the columns
+// |x_begin| and |x_end| excluded that are on the grid, if any.
+template <typename Visitor>
+bool VisitGridRow(int32_t y,
+                  int32_t x_begin,
+                  int32_t x_end,
+                  GridSize const& size,
+                  Visitor& visitor) {
+  if (y < 0 || y >= size.height_) {
+    return true;
+  }
+  x_begin = std::max(x_begin, int32_t(0));
+  x_end = std::min(x_end, size.width_);
+  if (x_begin >= x_end) {
+    return true;
+  }
+  return visitor(y, x_begin, x_end);
+}
+
+template <typename Visitor>
+bool WalkRows(dux::FVec2 start,
+              dux::FVec2 end,
+              GridSpec const& spec,
+              Visitor& visitor) {
+  GridSize size = spec.Size();
+  dux::GridPosition grid_start = spec.PositionOf(start);
+  dux::GridPosition grid_end = spec.PositionOf(end);
+  if (grid_start.y_ == grid_end.y_) {
+    return VisitGridRow(grid_start.y_, std::min(grid_start.x_, grid_end.x_),
+                        std::max(grid_start.x_, grid_end.x_) + 1, size,
+                        visitor);
+  }
+  if (grid_start.x_ == grid_end.x_) {
+    auto visit_position = [&visitor](GridPosition const& position) {
+      return visitor(position.y_, position.x_, position.x_ + 1);
+    };
+    return AxisAlignedWalkVisit(grid_start, grid_end, size, visit_position);
+  }
+
+  DiagonalWalk walk = StartDiagonalWalk(start, end, spec);
+  int32_t row_begin = walk.position_.x_;
+  for (int64_t i = 0; i < walk.iterations_; i++) {
+    int32_t row_end = walk.position_.x_ + 1;
+    int32_t y = walk.position_.y_;
+    if (walk.Step()) {
+      if (!VisitGridRow(y, row_begin, row_end, size, visitor)) {
+        return false;
+      }
+      row_begin = walk.position_.x_;
+    }
+  }
+  // The row of the last steps, which does not include the position reached
+  // after them.
+  if (!VisitGridRow(walk.position_.y_, row_begin, walk.position_.x_, size,
+                    visitor)) {
+    return false;
+  }
+  return VisitGridRow(walk.end_.y_, walk.end_.x_, walk.end_.x_ + 1, size,
+                      visitor);
+}
+
+}  // namespace internal
+
 }  // namespace dux
 
+#if defined(DUX_FIXED_HEADER_ONLY)
+#include "grid_walking.cpp"
+#endif
+
 #endif  // DUX_FILED_SRC_GRID_WALKING_H_
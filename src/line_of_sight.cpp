@@ -0,0 +1,83 @@
+#include "line_of_sight.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "parallel_for.h"
+
+namespace dux {
+
+DUX_FIXED_INLINE LineOfSight::LineOfSight(GridSpec const& spec)
+    : spec_(spec),
+      words_per_row_((static_cast<size_t>(spec.Size().width_) + 63) / 64),
+      blocked_(words_per_row_ * static_cast<size_t>(spec.Size().height_), 0) {
+  assert(spec.Size().width_ >= 0 && spec.Size().height_ >= 0);
+}
+
+DUX_FIXED_INLINE bool LineOfSight::IsBlocked(GridPosition position) const {
+  assert(position.x_ >= 0 && position.x_ < spec_.Size().width_);
+  assert(position.y_ >= 0 && position.y_ < spec_.Size().height_);
+  uint64_t word = blocked_[static_cast<size_t>(position.y_) * words_per_row_ +
+                           static_cast<size_t>(position.x_ / 64)];
+  return (word >> (position.x_ % 64)) & 1;
+}
+
+DUX_FIXED_INLINE void LineOfSight::SetBlocked(GridPosition position,
+                                              bool blocked) {
+  assert(position.x_ >= 0 && position.x_ < spec_.Size().width_);
+  assert(position.y_ >= 0 && position.y_ < spec_.Size().height_);
+  uint64_t& word = blocked_[static_cast<size_t>(position.y_) * words_per_row_ +
+                            static_cast<size_t>(position.x_ / 64)];
+  uint64_t bit = uint64_t(1) << (position.x_ % 64);
+  word = blocked ? word | bit : word & ~bit;
+}
+
+DUX_FIXED_INLINE void LineOfSight::Clear() {
+  std::fill(blocked_.begin(), blocked_.end(), 0);
+}
+
+DUX_FIXED_INLINE bool LineOfSight::IsRowBlocked(int32_t y,
+                                                int32_t x_begin,
+                                                int32_t x_end) const {
+  uint64_t const* row =
+      blocked_.data() + static_cast<size_t>(y) * words_per_row_;
+  int32_t first = x_begin / 64;
+  int32_t last = (x_end - 1) / 64;
+  uint64_t first_mask = ~uint64_t(0) << (x_begin % 64);
+  uint64_t last_mask = ~uint64_t(0) >> (63 - (x_end - 1) % 64);
+  if (first == last) {
+    return row[first] & first_mask & last_mask;
+  }
+  if (row[first] & first_mask) {
+    return true;
+  }
+  for (int32_t i = first + 1; i < last; i++) {
+    if (row[i]) {
+      return true;
+    }
+  }
+  return row[last] & last_mask;
+}
+
+DUX_FIXED_INLINE bool LineOfSight::IsVisible(FVec2 start, FVec2 end) const {
+  auto is_clear = [this](int32_t y, int32_t x_begin, int32_t x_end) {
+    return !IsRowBlocked(y, x_begin, x_end);
+  };
+  return internal::WalkRows(start, end, spec_, is_clear);
+}
+
+DUX_FIXED_INLINE void LineOfSight::VisibleMask(FVec2 origin,
+                                               FVec2 const* targets,
+                                               size_t count,
+                                               bool* visible,
+                                               ThreadPool* pool) const {
+  constexpr size_t kChunkSize = 64;
+  internal::ParallelFor(count, kChunkSize, pool,
+                        [&](size_t begin, size_t end) {
+                          for (size_t i = begin; i < end; i++) {
+                            visible[i] = IsVisible(origin, targets[i]);
+                          }
+                        });
+}
+
+}  // namespace dux
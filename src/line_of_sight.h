@@ -0,0 +1,69 @@
+#ifndef DUX_FIXED_SRC_LINE_OF_SIGHT_H_
+#define DUX_FIXED_SRC_LINE_OF_SIGHT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "grid_walking.h"
+
+namespace dux {
+
+// Occupancy grid of the squares of a |GridSpec|, stored as one bit per
+// square, which tells whether the lines walked by |Walk| cross a blocked
+// square.
+//
+// The results are the same as testing each position returned by |Walk|, but
+// the lines are walked without allocating, stop at the first blocked square,
+// and test the squares of a row 64 at a time.
+class LineOfSight {
+ public:
+  // Creates a grid of |spec| where no square is blocked.
+  explicit LineOfSight(GridSpec const& spec);
+  // Creates a grid of |size| squares of size 64 starting at (0, 0).
+  explicit LineOfSight(GridSize size) : LineOfSight(GridSpec(size)) {}
+
+  GridSpec const& Spec() const { return spec_; }
+  GridSize Size() const { return spec_.Size(); }
+
+  // |position| must be on the grid.
+  bool IsBlocked(GridPosition position) const;
+  void SetBlocked(GridPosition position, bool blocked);
+  // Unblocks all the squares.
+  void Clear();
+
+  // Returns true if none of the positions returned by
+  // |Walk(start, end, Spec())| is blocked.
+  bool IsVisible(FVec2 start, FVec2 end) const;
+
+  // Stores |IsVisible(origin, targets[i])| in |visible[i]| for each of the
+  // |count| targets.
+  // The targets are split between the threads of |pool|, including the
+  // calling one, in chunks of 64 targets taken by the threads as they
+  // become idle, or tested by the calling thread only if |pool| is null.
+  // No thread is created: the threads of |pool| are woken up, which costs a
+  // few microseconds, unless there are at most 64 targets.
+  void VisibleMask(FVec2 origin,
+                   FVec2 const* targets,
+                   size_t count,
+                   bool* visible,
+                   ThreadPool* pool = nullptr) const;
+
+ private:
+  // Returns true if one of the squares of the row |y| between the columns
+  // |x_begin| and |x_end| excluded is blocked.
+  bool IsRowBlocked(int32_t y, int32_t x_begin, int32_t x_end) const;
+
+  GridSpec spec_;
+  size_t words_per_row_;
+  // Bit x % 64 of the word x / 64 of each row is set if the square is blocked.
+  std::vector<uint64_t> blocked_;
+};
+
+}  // namespace dux
+
+#if defined(DUX_FIXED_HEADER_ONLY)
+#include "line_of_sight.cpp"
+#endif
+
+#endif  // DUX_FIXED_SRC_LINE_OF_SIGHT_H_
@@ -0,0 +1,45 @@
+#ifndef DUX_FIXED_SRC_PARALLEL_FOR_H_
+#define DUX_FIXED_SRC_PARALLEL_FOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+#include "thread_pool.h"
+
+namespace dux::internal {
+
+// Calls |f(begin, end)| for the consecutive ranges of |chunk_size| indices
+// (the last one may be shorter) covering [0, |count|[, from the threads of
+// |pool|, including the calling one, or from the calling thread only if
+// |pool| is null.
+// Each thread takes the next range when it is done with one, so that ranges
+// of uneven cost are spread over the threads. |f| must only write to the
+// memory of its range, so that the results do not depend on the threads.
+// When |count| fits in one chunk, the pool is not woken up.
+template <typename F>
+void ParallelFor(size_t count, size_t chunk_size, ThreadPool* pool, F&& f) {
+  size_t chunk_count = (count + chunk_size - 1) / chunk_size;
+  if (!pool || chunk_count <= 1) {
+    for (size_t begin = 0; begin < count; begin += chunk_size) {
+      f(begin, std::min(begin + chunk_size, count));
+    }
+    return;
+  }
+  std::atomic<size_t> next_chunk(0);
+  auto work = [&]() {
+    for (size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+         chunk < chunk_count;
+         chunk = next_chunk.fetch_add(1, std::memory_order_relaxed)) {
+      size_t begin = chunk * chunk_size;
+      f(begin, std::min(begin + chunk_size, count));
+    }
+  };
+  int thread_count = static_cast<int>(
+      std::min(chunk_count, static_cast<size_t>(pool->ThreadCount())));
+  pool->Run(thread_count, work);
+}
+
+}  // namespace dux::internal
+
+#endif  // DUX_FIXED_SRC_PARALLEL_FOR_H_
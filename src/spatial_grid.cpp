@@ -0,0 +1,83 @@
+#include "spatial_grid.h"
+
+#include <cassert>
+
+namespace dux {
+
+DUX_FIXED_INLINE SpatialGrid::SpatialGrid(GridSpec const& spec)
+    : spec_(spec) {
+  GridSize size = spec.Size();
+  assert(size.width_ >= 0 && size.height_ >= 0);
+  cell_begin_.resize(
+      static_cast<size_t>(size.width_) * static_cast<size_t>(size.height_) + 1,
+      0);
+}
+
+DUX_FIXED_INLINE size_t SpatialGrid::CellIndex(FVec2 position) const {
+  GridSize size = spec_.Size();
+  GridPosition p = spec_.PositionOf(position);
+  size_t x = static_cast<size_t>(std::clamp(p.x_, int32_t(0), size.width_ - 1));
+  size_t y =
+      static_cast<size_t>(std::clamp(p.y_, int32_t(0), size.height_ - 1));
+  return y * static_cast<size_t>(size.width_) + x;
+}
+
+DUX_FIXED_INLINE void SpatialGrid::Build(uint32_t const* ids,
+                                         FVec2 const* positions,
+                                         size_t count) {
+  assert(count <= UINT32_MAX);
+  size_t cell_count = cell_begin_.size() - 1;
+  if (cell_count == 0) {
+    // There is no square to store the entities in.
+    ids_.clear();
+    positions_.clear();
+    entity_cells_.clear();
+    return;
+  }
+  ids_.resize(count);
+  positions_.resize(count);
+  entity_cells_.resize(count);
+  // Counts the entities of each square in |cell_begin_[i + 1]|.
+  std::fill(cell_begin_.begin(), cell_begin_.end(), 0);
+  for (size_t i = 0; i < count; i++) {
+    size_t cell = CellIndex(positions[i]);
+    entity_cells_[i] = static_cast<uint32_t>(cell);
+    cell_begin_[cell + 1]++;
+  }
+  for (size_t cell = 0; cell < cell_count; cell++) {
+    cell_begin_[cell + 1] += cell_begin_[cell];
+  }
+  // Stores the entities at |cell_begin_[i]|, which then becomes the end of
+  // the square i, i.e. the beginning of the square i + 1.
+  for (size_t i = 0; i < count; i++) {
+    uint32_t index = cell_begin_[entity_cells_[i]]++;
+    ids_[index] = ids ? ids[i] : static_cast<uint32_t>(i);
+    positions_[index] = positions[i];
+  }
+  for (size_t cell = cell_count; cell > 0; cell--) {
+    cell_begin_[cell] = cell_begin_[cell - 1];
+  }
+  cell_begin_[0] = 0;
+}
+
+DUX_FIXED_INLINE void SpatialGrid::Build(FVec2 const* positions,
+                                         size_t count) {
+  Build(nullptr, positions, count);
+}
+
+DUX_FIXED_INLINE void SpatialGrid::QueryRadius(
+    FVec2 center,
+    FInt radius,
+    std::vector<uint32_t>& out) const {
+  QueryRadius(center, radius,
+              [&out](uint32_t id, FVec2 const&) { out.push_back(id); });
+}
+
+DUX_FIXED_INLINE void SpatialGrid::QueryBox(FVec2 min,
+                                            FVec2 max,
+                                            std::vector<uint32_t>& out) const {
+  QueryBox(min, max,
+           [&out](uint32_t id, FVec2 const&) { out.push_back(id); });
+}
+
+}  // namespace dux
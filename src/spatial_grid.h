@@ -0,0 +1,133 @@
+#ifndef DUX_FIXED_SRC_SPATIAL_GRID_H_
+#define DUX_FIXED_SRC_SPATIAL_GRID_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "grid_walking.h"
+
+namespace dux {
+
+// Broadphase for neighbour and collision queries: entities, identified by a
+// |uint32_t| id, bucketed by the square of a |GridSpec| containing their
+// position.
+//
+// The buckets are stored contiguously, sorted by square (a compressed sparse
+// row layout), and are rebuilt from scratch by |Build| with a counting sort:
+// rebuilding every tick takes a time linear in the number of entities and of
+// squares, and does not allocate once the grid has held as many entities.
+//
+// The entities outside of the grid are stored in the squares of its border,
+// so that they are still found by the queries.
+class SpatialGrid {
+ public:
+  explicit SpatialGrid(GridSpec const& spec);
+  // A grid of |size| squares of size 64 starting at (0, 0).
+  explicit SpatialGrid(GridSize size) : SpatialGrid(GridSpec(size)) {}
+
+  GridSpec const& Spec() const { return spec_; }
+  // Returns the number of entities.
+  size_t Size() const { return ids_.size(); }
+
+  // Replaces the entities by the |count| entities whose ids are |ids[i]| and
+  // positions are |positions[i]|.
+  // A grid without squares (0 wide or 0 high) holds no entity: it is left
+  // empty whatever |count| is.
+  void Build(uint32_t const* ids, FVec2 const* positions, size_t count);
+  // Same as above, with the indices of |positions| as ids.
+  void Build(FVec2 const* positions, size_t count);
+
+  // Calls |visitor(id, position)| for each entity at a distance of at most
+  // |radius| from |center|, i.e. whose |SquareLengthFrom(center)| is at most
+  // |radius| * |radius|.
+  template <typename Visitor>
+  void QueryRadius(FVec2 center, FInt radius, Visitor&& visitor) const;
+  // Appends the ids of the entities found by the above to |out|.
+  void QueryRadius(FVec2 center, FInt radius, std::vector<uint32_t>& out) const;
+
+  // Calls |visitor(id, position)| for each entity whose position p is such
+  // that |min| <= p <= |max|.
+  template <typename Visitor>
+  void QueryBox(FVec2 min, FVec2 max, Visitor&& visitor) const;
+  // Appends the ids of the entities found by the above to |out|.
+  void QueryBox(FVec2 min, FVec2 max, std::vector<uint32_t>& out) const;
+
+ private:
+  // Returns the index of the square containing |position|, or of the closest
+  // square of the border if it is outside of the grid.
+  size_t CellIndex(FVec2 position) const;
+
+  // Calls |visitor(begin, end)| with the ranges of entities of the squares
+  // intersecting the rectangle between |min| and |max|.
+  template <typename Visitor>
+  void VisitCells(FVec2 min, FVec2 max, Visitor& visitor) const;
+
+  GridSpec spec_;
+  // The entities of the square i, in row-major order, are the ones in
+  // [cell_begin_[i], cell_begin_[i + 1][.
+  std::vector<uint32_t> cell_begin_;
+  std::vector<uint32_t> ids_;
+  std::vector<FVec2> positions_;
+  // Square of each entity passed to |Build|, reused between builds.
+  std::vector<uint32_t> entity_cells_;
+};
+
+template <typename Visitor>
+void SpatialGrid::VisitCells(FVec2 min, FVec2 max, Visitor& visitor) const {
+  GridSize size = spec_.Size();
+  if (ids_.empty() || size.width_ <= 0 || size.height_ <= 0) {
+    return;
+  }
+  GridPosition first = spec_.PositionOf(min);
+  GridPosition last = spec_.PositionOf(max);
+  // The squares of the border also hold the entities beyond them.
+  int32_t x_begin = std::clamp(first.x_, int32_t(0), size.width_ - 1);
+  int32_t x_end = std::clamp(last.x_, int32_t(0), size.width_ - 1);
+  int32_t y_begin = std::clamp(first.y_, int32_t(0), size.height_ - 1);
+  int32_t y_end = std::clamp(last.y_, int32_t(0), size.height_ - 1);
+  for (int32_t y = y_begin; y <= y_end; y++) {
+    size_t row = static_cast<size_t>(y) * static_cast<size_t>(size.width_);
+    // The squares of a row are contiguous.
+    for (int32_t x = x_begin; x <= x_end; x++) {
+      visitor(cell_begin_[row + x], cell_begin_[row + x + 1]);
+    }
+  }
+}
+
+template <typename Visitor>
+void SpatialGrid::QueryRadius(FVec2 center,
+                              FInt radius,
+                              Visitor&& visitor) const {
+  FVec2 extent(radius, radius);
+  FInt square_radius = radius * radius;
+  auto visit_cell = [&](uint32_t begin, uint32_t end) {
+    for (uint32_t i = begin; i < end; i++) {
+      if (positions_[i].SquareLengthFrom(center) <= square_radius) {
+        visitor(ids_[i], positions_[i]);
+      }
+    }
+  };
+  VisitCells(center - extent, center + extent, visit_cell);
+}
+
+template <typename Visitor>
+void SpatialGrid::QueryBox(FVec2 min, FVec2 max, Visitor&& visitor) const {
+  auto visit_cell = [&](uint32_t begin, uint32_t end) {
+    for (uint32_t i = begin; i < end; i++) {
+      if (positions_[i] >= min && positions_[i] <= max) {
+        visitor(ids_[i], positions_[i]);
+      }
+    }
+  };
+  VisitCells(min, max, visit_cell);
+}
+
+}  // namespace dux
+
+#if defined(DUX_FIXED_HEADER_ONLY)
+#include "spatial_grid.cpp"
+#endif
+
+#endif  // DUX_FIXED_SRC_SPATIAL_GRID_H_
@@ -0,0 +1,80 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace dux {
+
+DUX_FIXED_INLINE ThreadPool::ThreadPool(int thread_count)
+    : work_(nullptr),
+      context_(nullptr),
+      generation_(0),
+      helper_count_(0),
+      running_count_(0),
+      stopping_(false) {
+  int helper_count = std::max(thread_count, 1) - 1;
+  threads_.reserve(static_cast<size_t>(helper_count));
+  for (int i = 0; i < helper_count; i++) {
+    threads_.emplace_back(&ThreadPool::ThreadLoop, this, i);
+  }
+}
+
+DUX_FIXED_INLINE ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  work_ready_.notify_all();
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+}
+
+DUX_FIXED_INLINE void ThreadPool::Run(int thread_count,
+                                      void (*work)(void*),
+                                      void* context) {
+  int helper_count = std::clamp(thread_count, 1, ThreadCount()) - 1;
+  if (helper_count == 0) {
+    work(context);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    work_ = work;
+    context_ = context;
+    helper_count_ = helper_count;
+    running_count_ = helper_count;
+    generation_++;
+  }
+  work_ready_.notify_all();
+  work(context);
+  std::unique_lock<std::mutex> lock(mutex_);
+  work_done_.wait(lock, [this] { return running_count_ == 0; });
+  work_ = nullptr;
+  context_ = nullptr;
+}
+
+DUX_FIXED_INLINE void ThreadPool::ThreadLoop(int index) {
+  uint64_t generation = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    work_ready_.wait(
+        lock, [&] { return stopping_ || generation_ != generation; });
+    if (stopping_) {
+      return;
+    }
+    generation = generation_;
+    if (index >= helper_count_) {
+      continue;
+    }
+    void (*work)(void*) = work_;
+    void* context = context_;
+    lock.unlock();
+    work(context);
+    lock.lock();
+    if (--running_count_ == 0) {
+      work_done_.notify_one();
+    }
+  }
+}
+
+}  // namespace dux
@@ -0,0 +1,70 @@
+#ifndef DUX_FIXED_SRC_THREAD_POOL_H_
+#define DUX_FIXED_SRC_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "fixed_int.h"
+
+namespace dux {
+
+// Threads kept waiting between the batches of work split by |WalkMany| and
+// |LineOfSight::VisibleMask|, so that calling them every tick does not
+// create threads. The pool is owned by the caller, e.g. next to the world it
+// updates, and is used by one batch at a time.
+class ThreadPool {
+ public:
+  // Starts |thread_count| - 1 threads: the thread calling |Run| is the last
+  // one.
+  explicit ThreadPool(int thread_count);
+  ~ThreadPool();
+
+  ThreadPool(ThreadPool const&) = delete;
+  ThreadPool& operator=(ThreadPool const&) = delete;
+
+  // Returns the number of threads, including the calling one.
+  int ThreadCount() const { return static_cast<int>(threads_.size()) + 1; }
+
+  // Calls |work()| from |thread_count| threads, including the calling one,
+  // and returns once all the calls have returned. |thread_count| is clamped
+  // to [1, |ThreadCount()|].
+  // Must not be called from several threads at the same time, nor from
+  // |work|.
+  template <typename Work>
+  void Run(int thread_count, Work& work) {
+    Run(
+        thread_count,
+        [](void* context) { (*static_cast<Work*>(context))(); }, &work);
+  }
+
+ private:
+  void Run(int thread_count, void (*work)(void*), void* context);
+  // Waits for the work of each |Run|, if it needs the thread |index|.
+  void ThreadLoop(int index);
+
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable work_ready_;
+  std::condition_variable work_done_;
+  // The work of the current |Run|, guarded by |mutex_|.
+  void (*work_)(void*);
+  void* context_;
+  // Incremented by each |Run|, so that the threads know when to work.
+  uint64_t generation_;
+  // Number of threads of |threads_| working on the current |Run|, and number
+  // of them that have not finished yet.
+  int helper_count_;
+  int running_count_;
+  bool stopping_;
+};
+
+}  // namespace dux
+
+#if defined(DUX_FIXED_HEADER_ONLY)
+#include "thread_pool.cpp"
+#endif
+
+#endif  // DUX_FIXED_SRC_THREAD_POOL_H_
@@ -3,18 +3,32 @@
 #include <cstdio>
 #include <cstdlib>
 
+#include "test_fixed_batch.h"
+#include "test_fixed_divisor.h"
 #include "test_fixed_int.h"
 #include "test_fixed_trig.h"
 #include "test_fixed_vec2.h"
+#include "test_fixed_vec2_array.h"
+#include "test_fixed_vec32.h"
 #include "test_grid_walking.h"
+#include "test_line_of_sight.h"
+#include "test_spatial_grid.h"
+#include "test_thread_pool.h"
 
 int main(int argc, char* argv[]) {
   (void)argc;
   (void)argv;
   TestFInt();
+  TestBatch();
+  TestFIntDivisor();
   TestFVec2();
+  TestFVec2Array();
+  TestFVec32();
   TestTrig();
   TestGridWalking();
+  TestLineOfSight();
+  TestSpatialGrid();
+  TestThreadPool();
   printf("tests successfully passed\n");
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,167 @@
+#include "test_fixed_batch.h"
+
+#include <cassert>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "fixed_batch.h"
+
+using namespace dux;
+using namespace dux::batch;
+
+namespace {
+
+std::mt19937_64 rng(7);
+
+// Returns random raw values in [-max, max].
+std::vector<RawType> RandRawValues(size_t count, RawType max) {
+  std::uniform_int_distribution<RawType> uid(-max, max);
+  std::vector<RawType> v(count);
+  for (RawType& value : v) {
+    value = uid(rng);
+  }
+  return v;
+}
+
+FInt F(RawType raw_value) {
+  return FInt::FromRawValue(raw_value);
+}
+
+void TestBackend(Backend backend, size_t count) {
+  SetActiveBackend(backend);
+  assert(ActiveBackend() == backend);
+
+  // Large enough to exercise the sign handling, small enough to not overflow
+  // in the multiplications and divisions.
+  std::vector<RawType> a = RandRawValues(count, 1LL << 40);
+  std::vector<RawType> b = RandRawValues(count, 1LL << 40);
+  std::vector<RawType> small_a = RandRawValues(count, 1LL << 31);
+  std::vector<RawType> small_b = RandRawValues(count, 1LL << 31);
+  for (RawType& value : small_b) {
+    if (value == 0) {
+      value = 1;
+    }
+  }
+  std::vector<RawType> out(count);
+
+  Add(a.data(), b.data(), out.data(), count);
+  for (size_t i = 0; i < count; i++) {
+    assert(out[i] == (F(a[i]) + F(b[i])).raw_value_);
+  }
+  Sub(a.data(), b.data(), out.data(), count);
+  for (size_t i = 0; i < count; i++) {
+    assert(out[i] == (F(a[i]) - F(b[i])).raw_value_);
+  }
+  Mul(small_a.data(), small_b.data(), out.data(), count);
+  for (size_t i = 0; i < count; i++) {
+    assert(out[i] == (F(small_a[i]) * F(small_b[i])).raw_value_);
+  }
+  Div(small_a.data(), small_b.data(), out.data(), count);
+  for (size_t i = 0; i < count; i++) {
+    assert(out[i] == (F(small_a[i]) / F(small_b[i])).raw_value_);
+  }
+  MulFInt(small_a.data(), F(-123456789), out.data(), count);
+  for (size_t i = 0; i < count; i++) {
+    assert(out[i] == (F(small_a[i]) * F(-123456789)).raw_value_);
+  }
+  MulFInt(small_a.data(), -3_fx / 7_fx, out.data(), count);
+  for (size_t i = 0; i < count; i++) {
+    assert(out[i] == (F(small_a[i]) * (-3_fx / 7_fx)).raw_value_);
+  }
+  for (FInt divisor : {3_fx, -7_fx / 5_fx, F(1), F(-123456789)}) {
+    DivFInt(small_a.data(), divisor, out.data(), count);
+    for (size_t i = 0; i < count; i++) {
+      assert(out[i] == (F(small_a[i]) / divisor).raw_value_);
+    }
+  }
+  MulInt(a.data(), -77, out.data(), count);
+  for (size_t i = 0; i < count; i++) {
+    assert(out[i] == (F(a[i]) * -77).raw_value_);
+  }
+  MulInt(a.data(), 123456, out.data(), count);
+  for (size_t i = 0; i < count; i++) {
+    assert(out[i] == (F(a[i]) * 123456).raw_value_);
+  }
+  Floor(a.data(), out.data(), count);
+  for (size_t i = 0; i < count; i++) {
+    assert(out[i] == F(a[i]).Floor().raw_value_);
+  }
+  Ceil(a.data(), out.data(), count);
+  for (size_t i = 0; i < count; i++) {
+    assert(out[i] == F(a[i]).Ceil().raw_value_);
+  }
+  Round(a.data(), out.data(), count);
+  for (size_t i = 0; i < count; i++) {
+    assert(out[i] == F(a[i]).Round().raw_value_);
+  }
+  Abs(a.data(), out.data(), count);
+  for (size_t i = 0; i < count; i++) {
+    assert(out[i] == F(a[i]).Abs().raw_value_);
+  }
+
+  // In place.
+  std::vector<RawType> c = a;
+  Add(c.data(), b.data(), c.data(), count);
+  for (size_t i = 0; i < count; i++) {
+    assert(c[i] == (F(a[i]) + F(b[i])).raw_value_);
+  }
+
+  // Values that are exact integers, or halfway between integers.
+  std::vector<RawType> edges = {0,
+                                1,
+                                -1,
+                                FInt::kHighBitOfFraction,
+                                -FInt::kHighBitOfFraction,
+                                FInt::kHighBitOfFraction - 1,
+                                -FInt::kHighBitOfFraction + 1,
+                                (3_fx).raw_value_,
+                                (-3_fx).raw_value_,
+                                FIntMin.raw_value_ + 1};
+#if !defined(DUX_FIXED_CHECKED_ARITHMETIC)
+  // Rounding it up overflows.
+  edges.push_back(FIntMax.raw_value_);
+#endif
+  out.resize(edges.size());
+  Round(edges.data(), out.data(), edges.size());
+  for (size_t i = 0; i < edges.size(); i++) {
+    assert(out[i] == F(edges[i]).Round().raw_value_);
+  }
+  Ceil(edges.data(), out.data(), edges.size());
+  for (size_t i = 0; i < edges.size(); i++) {
+    assert(out[i] == F(edges[i]).Ceil().raw_value_);
+  }
+  Abs(edges.data(), out.data(), edges.size());
+  for (size_t i = 0; i < edges.size(); i++) {
+    assert(out[i] == F(edges[i]).Abs().raw_value_);
+  }
+  // Products that are negative and not multiples of 2^kShift must be rounded
+  // toward zero.
+  std::vector<RawType> factors = {-1, 1, -4095, 4095, -4097, 4097, 3};
+  std::vector<RawType> products(factors.size());
+  Mul(factors.data(), edges.data(), products.data(), factors.size());
+  for (size_t i = 0; i < factors.size(); i++) {
+    assert(products[i] == (F(factors[i]) * F(edges[i])).raw_value_);
+  }
+}
+
+}  // namespace
+
+void TestBatch() {
+  Backend default_backend = ActiveBackend();
+  assert(IsBackendSupported(default_backend));
+  assert(IsBackendSupported(Backend::kScalar));
+
+  for (Backend backend :
+       {Backend::kScalar, Backend::kSse42, Backend::kAvx2}) {
+    if (!IsBackendSupported(backend)) {
+      printf("skipping unsupported batch backend %s\n", BackendName(backend));
+      continue;
+    }
+    // Sizes that leave values for the scalar tail.
+    for (size_t count : {0, 1, 2, 3, 4, 5, 7, 8, 9, 1000, 1001, 1002, 1003}) {
+      TestBackend(backend, count);
+    }
+  }
+  SetActiveBackend(default_backend);
+}
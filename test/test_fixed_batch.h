@@ -0,0 +1,6 @@
+#ifndef DUX_FILED_TEST_TEST_FIXED_BATCH_H_
+#define DUX_FILED_TEST_TEST_FIXED_BATCH_H_
+
+void TestBatch();
+
+#endif  // DUX_FILED_TEST_TEST_FIXED_BATCH_H_
@@ -0,0 +1,90 @@
+#include "test_fixed_divisor.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "fixed_divisor.h"
+
+using namespace dux;
+
+namespace {
+
+std::mt19937_64 rng(17);
+
+// Returns the divisors to test: small and large magnitudes, powers of two and
+// their neighbours, of both signs.
+std::vector<FInt> Divisors() {
+  std::vector<int64_t> raw_values = {1, 2, 3, 5, 7, 4095, 4096, 4097, 6434,
+                                     25736, 1LL << 40, (1LL << 62) + 1,
+                                     FIntMax.raw_value_};
+  for (int shift = 0; shift < 63; shift++) {
+    raw_values.push_back(1LL << shift);
+    raw_values.push_back((1LL << shift) + 1);
+    raw_values.push_back((1LL << shift) - 1);
+  }
+  std::uniform_int_distribution<int> shifts(0, 62);
+  for (int i = 0; i < 200; i++) {
+    raw_values.push_back((rng() >> 1) >> shifts(rng));
+  }
+  std::vector<FInt> divisors = {FIntMin};
+  for (int64_t raw_value : raw_values) {
+    if (raw_value != 0) {
+      divisors.push_back(FInt::FromRawValue(raw_value));
+      divisors.push_back(FInt::FromRawValue(-raw_value));
+    }
+  }
+  return divisors;
+}
+
+// Returns dividends whose intermediate result in |operator/| does not
+// overflow.
+std::vector<FInt> Dividends() {
+  constexpr int64_t kLimit = 1LL << 51;
+  std::vector<FInt> dividends;
+  std::vector<int64_t> raw_values = {0,          1,           4095, 4096,
+                                     kLimit - 1, kLimit - 4096, 123456789};
+  for (int64_t raw_value : raw_values) {
+    dividends.push_back(FInt::FromRawValue(raw_value));
+    dividends.push_back(FInt::FromRawValue(-raw_value));
+  }
+  std::uniform_int_distribution<int64_t> uid(-kLimit + 1, kLimit - 1);
+  std::uniform_int_distribution<int> shifts(0, 51);
+  for (int i = 0; i < 300; i++) {
+    dividends.push_back(FInt::FromRawValue(uid(rng) >> shifts(rng)));
+  }
+  return dividends;
+}
+
+}  // namespace
+
+void TestFIntDivisor() {
+  static_assert(FIntDivisor(3_fx).Divide(1_fx) == 1_fx / 3_fx);
+  static_assert(1_fx / FIntDivisor(-3_fx) == 1_fx / -3_fx);
+  static_assert(FIntDivisor(2_fx).Divisor() == 2_fx);
+
+  // |Divide| is identical to |operator/|.
+  std::vector<FInt> dividends = Dividends();
+  for (FInt divisor : Divisors()) {
+    FIntDivisor fint_divisor(divisor);
+    for (FInt dividend : dividends) {
+      assert(fint_divisor.Divide(dividend) == dividend / divisor);
+    }
+  }
+
+  // |Reciprocal|.
+  static_assert((2_fx).Reciprocal() == FInt::FromFraction(1, 2));
+  static_assert((-3_fx).Reciprocal() == 1_fx / -3_fx);
+  std::uniform_int_distribution<int64_t> uid(-(1LL << 30), 1LL << 30);
+  for (int i = 0; i < 10000; i++) {
+    FInt x = FInt::FromRawValue(uid(rng));
+    FInt y = FInt::FromRawValue(uid(rng) >> (i % 30));
+    if (y == FInt()) {
+      continue;
+    }
+    int64_t difference =
+        std::abs((x * y.Reciprocal()).raw_value_ - (x / y).raw_value_);
+    assert(difference <= x.Abs().Int64() + 1);
+  }
+}
@@ -0,0 +1,6 @@
+#ifndef DUX_FIXED_TEST_TEST_FIXED_DIVISOR_H_
+#define DUX_FIXED_TEST_TEST_FIXED_DIVISOR_H_
+
+void TestFIntDivisor();
+
+#endif  // DUX_FIXED_TEST_TEST_FIXED_DIVISOR_H_
@@ -1,7 +1,10 @@
 #include "test_fixed_int.h"
 
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <random>
+#include <type_traits>
 
 #include "fixed_int.h"
 #include "utils.h"
@@ -10,6 +13,408 @@ using namespace dux;
 using namespace dux::trig;
 using namespace dux_test_utils;
 
+namespace {
+
+// The Newton iteration used by |FInt::Sqrt| up to version 1.0, which the
+// current implementation must match bit for bit.
+FInt LegacySqrt(FInt v) {
+  FInt::RawType raw_value = v.raw_value_;
+  if (raw_value < 0x7FFFFFFF) {
+    int32_t value = static_cast<int32_t>(raw_value);
+    int32_t n = (value >> 1) + 1;
+    int32_t n1 = (n + (value / n)) >> 1;
+    while (n1 < n) {
+      n = n1;
+      n1 = (n + (value / n)) >> 1;
+    }
+    return FInt::FromRawValue(static_cast<FInt::RawType>(n1)
+                              << FInt::kHalfShift);
+  }
+  FInt::RawType n = (raw_value >> 1) + 1;
+  FInt::RawType n1 = (n + (raw_value / n)) >> 1;
+  while (n1 < n) {
+    n = n1;
+    n1 = (n + (raw_value / n)) >> 1;
+  }
+  return FInt::FromRawValue(n1 << FInt::kHalfShift);
+}
+
+void TestSqrtMatchesLegacySqrt() {
+  // All the small values.
+  for (FInt::RawType raw = 1; raw < (1 << 20); raw++) {
+    FInt v = FInt::FromRawValue(raw);
+    assert(v.Sqrt() == LegacySqrt(v));
+  }
+  // Values around perfect squares, where rounding differences would show.
+  for (uint64_t root = 1; root < 3037000499ULL; root += 7919 + root / 64) {
+    for (int64_t offset = -2; offset <= 2; offset++) {
+      FInt v = FInt::FromRawValue(root * root + 2 * root + offset);
+      assert(v.Sqrt() == LegacySqrt(v));
+    }
+  }
+  // Random values of every magnitude, up to the largest one.
+  std::mt19937_64 rng(42);
+  for (int i = 0; i < 100000; i++) {
+    FInt::RawType raw = static_cast<FInt::RawType>(rng() >> (1 + (i % 63)));
+    if (raw == 0) {
+      continue;
+    }
+    FInt v = FInt::FromRawValue(raw);
+    assert(v.Sqrt() == LegacySqrt(v));
+  }
+  assert(FIntMax.Sqrt() == LegacySqrt(FIntMax));
+  assert(FInt::FromRawValue(0x7FFFFFFE).Sqrt() ==
+         LegacySqrt(FInt::FromRawValue(0x7FFFFFFE)));
+  assert(FInt::FromRawValue(0x7FFFFFFF).Sqrt() ==
+         LegacySqrt(FInt::FromRawValue(0x7FFFFFFF)));
+}
+
+// Test the precisions other than |FInt|.
+void TestFixedPrecisions() {
+  using Q16 = Fixed<int32_t, 16>;
+  using Q20 = Fixed<int64_t, 20>;
+  static_assert(std::is_same_v<FInt, Fixed<int64_t, 12>>);
+  static_assert(sizeof(Q16) == 4);
+  // The conversions between precisions are explicit.
+  static_assert(!std::is_convertible_v<Q20, FInt>);
+  static_assert(!std::is_convertible_v<FInt, Q20>);
+  static_assert(std::is_constructible_v<Q20, FInt>);
+
+  // Arithmetic.
+  static_assert(Q16::FromInt(3) * Q16::FromInt(4) == Q16::FromInt(12));
+  static_assert((Q16::FromInt(1) / Q16::FromInt(3)).raw_value_ == 21845);
+  static_assert((Q16::FromInt(-1) / Q16::FromInt(3)).raw_value_ == -21845);
+  // The intermediate results of the 32-bit multiplications and divisions are
+  // 64-bit.
+  static_assert(Q16::FromInt(200) * Q16::FromInt(100) == Q16::FromInt(20000));
+  static_assert(Q16::FromInt(20000) / Q16::FromInt(200) == Q16::FromInt(100));
+  static_assert(Q16::FromFraction(-5, 2).Floor() == Q16::FromInt(-3));
+  static_assert(Q16::FromFraction(-5, 2).Ceil() == Q16::FromInt(-2));
+  static_assert(Q16::FromFraction(-5, 2).Round() == Q16::FromInt(-2));
+  static_assert(Q16::FromFraction(-11, 4).Round() == Q16::FromInt(-3));
+  static_assert(Q20::FromInt(1 << 20) * Q20::FromInt(3) ==
+                Q20::FromInt(3 << 20));
+  assert(Q16::FromInt(16).Sqrt() == Q16::FromInt(4));
+  assert(Q20::FromInt(1 << 20).Sqrt() == Q20::FromInt(1 << 10));
+  // |Sqrt| computes the square root of the raw value, so the result has half of
+  // the fractional bits.
+  for (int i = 0; i < 1000; i++) {
+    double v = i * 1.37;
+    assert(std::abs(Q20::FromDouble(v).Sqrt().DoubleValue() - std::sqrt(v)) <
+           1.0 / (1 << 10));
+    assert(std::abs(Q16::FromDouble(v).Sqrt().DoubleValue() - std::sqrt(v)) <
+           1.0 / (1 << 8));
+  }
+  assert(std::abs(Exp(Q20::FromInt(3)).DoubleValue() - std::exp(3.0)) < 1e-3);
+  assert(std::abs(Ln(Q20::FromInt(10)).DoubleValue() - std::log(10.0)) < 1e-3);
+  assert(std::abs(Pow(Q20::FromInt(2), Q20::FromInt(10)).DoubleValue() -
+                  1024) < 1e-3);
+  assert(Exp(Q16::FromInt(20)) ==
+         Q16::FromRawValue(std::numeric_limits<int32_t>::max()));
+  assert(Q16::FromFraction(-1, 2).ToString() == "-0.32768");
+
+  // Conversions truncate the fractional bits toward zero.
+  static_assert(Q20(FInt::FromRawValue(-3)).raw_value_ == -(3 << 8));
+  static_assert(FInt(Q20::FromRawValue(300)).raw_value_ == 1);
+  static_assert(FInt(Q20::FromRawValue(-300)).raw_value_ == -1);
+  static_assert(FInt(Q16::FromInt(-7)) == -7_fx);
+  static_assert(Q16(FInt::FromFraction(1, 4)) == Q16::FromFraction(1, 4));
+
+  // The pi constants of each precision.
+  static_assert(FixedHalfPi<Q20>.raw_value_ == 1647099);
+  static_assert(FixedPi<Q20>.raw_value_ == 2 * 1647099);
+  static_assert(FixedHalfPi<Q16>.raw_value_ == 102944);
+  static_assert(FixedQuarterPi<Q16>.raw_value_ == 51472);
+}
+
+// Test the 32-bit storage type |FInt32|.
+void TestFInt32() {
+  static_assert(sizeof(FInt32) == 4);
+  static_assert(FInt32::kShift == FInt::kShift);
+  static_assert(Widen(FInt32Max) == FInt::FromRawValue(0x7FFFFFFF));
+  static_assert(Widen(FInt32Min) == FInt::FromRawValue(-0x80000000LL));
+  static_assert(Widen(FInt32::FromFraction(-5, 3)) ==
+                FInt::FromFraction(-5, 3));
+
+  static_assert(FitsInFInt32(524287_fx));
+  static_assert(FitsInFInt32(-524288_fx));
+  static_assert(!FitsInFInt32(524288_fx));
+  static_assert(!FitsInFInt32(-524288_fx - FInt::FromRawValue(1)));
+  static_assert(NarrowSaturated(524288_fx) == FInt32Max);
+  static_assert(NarrowSaturated(-FIntMax) == FInt32Min);
+  static_assert(NarrowSaturated(-3_fx / 7_fx) == FInt32::FromFraction(-3, 7));
+
+  // Every value in range survives the round trip.
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<int32_t> uid(
+      std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max());
+  for (int i = 0; i < 10000; i++) {
+    FInt value = FInt::FromRawValue(uid(rng));
+    bool success = false;
+    FInt32 narrowed = Narrow(value, success);
+    assert(success);
+    assert(Widen(narrowed) == value);
+    assert(FInt(narrowed) == value);
+    assert(FInt32(value) == narrowed);
+  }
+  bool success = true;
+  assert(Narrow(FIntMax, success) == FInt32Max);
+  assert(!success);
+  assert(Narrow(-1000000_fx, success) == FInt32Min);
+  assert(!success);
+
+  // Arithmetic in 32 bits, with a 64-bit intermediate.
+  assert(FInt32::FromInt(-700) * FInt32::FromInt(700) ==
+         FInt32::FromInt(-490000));
+  assert(Widen(FInt32::FromInt(1) / FInt32::FromInt(3)) == 1_fx / 3_fx);
+  assert(Widen(FInt32::FromInt(2).Sqrt()) == (2_fx).Sqrt());
+}
+
+// Test |MulWide| and |DivWide|, and the operators when
+// DUX_FIXED_WIDE_ARITHMETIC is defined.
+void TestWideArithmetic() {
+  std::mt19937_64 rng(11);
+  // Products and dividends that fit in 64 bits give the same results as the
+  // 64-bit computations.
+  std::uniform_int_distribution<int64_t> small(-(1LL << 31), 1LL << 31);
+  for (int i = 0; i < 10000; i++) {
+    FInt a = FInt::FromRawValue(small(rng));
+    FInt b = FInt::FromRawValue(small(rng));
+    assert(a.MulWide(b).raw_value_ == (a.raw_value_ * b.raw_value_) / 4096);
+    if (b != FInt()) {
+      assert(a.DivWide(b).raw_value_ == (a.raw_value_ * 4096) / b.raw_value_);
+    }
+  }
+  // Products and dividends that do not fit in 64 bits.
+  std::uniform_int_distribution<int64_t> large(-(1LL << 50), 1LL << 50);
+  std::uniform_int_distribution<int32_t> factors(-1000, 1000);
+  for (int i = 0; i < 10000; i++) {
+    FInt a = FInt::FromRawValue(large(rng));
+    int32_t factor = factors(rng);
+    assert(a.MulWide(FInt::FromInt(factor)) == a * factor);
+    if (factor != 0) {
+      assert((a * factor).DivWide(FInt::FromInt(factor)) == a);
+      assert(a.DivWide(FInt::FromInt(factor)) == a / factor);
+    }
+    // Rounds toward zero, like the 64-bit computation.
+    assert(a.MulWide(FInt::FromFraction(1, 2)) == a / 2);
+    assert(a.MulWide(-FInt::FromFraction(1, 2)) == -a / 2);
+  }
+  static_assert(FInt::FromInt(3000000).MulWide(FInt::FromInt(3000000)) ==
+                FInt::FromInt(3000000) * 3000000);
+  static_assert(FInt::FromInt(2000000000).DivWide(FInt::FromInt(-1000)) ==
+                FInt::FromInt(-2000000));
+  static_assert(FIntMax.DivWide(FIntMax) == 1_fx);
+  static_assert(FIntMin.MulWide(1_fx) == FIntMin);
+  // 32-bit numbers already use a 64-bit intermediate result.
+  static_assert(FInt32::FromInt(300).MulWide(FInt32::FromInt(300)) ==
+                FInt32::FromInt(90000));
+
+#if defined(DUX_FIXED_WIDE_ARITHMETIC)
+  FInt big = FInt::FromInt(5000000);
+  assert(big * big == big * 5000000);
+  assert((big * 5000000) / big == big);
+#endif
+}
+
+// Test the |Checked*| and |Saturating*| functions.
+void TestOverflowHandling() {
+  constexpr FInt kOne = 1_fx;
+  constexpr FInt kEpsilon = FInt::FromRawValue(1);
+  static_assert(*(2_fx).CheckedAdd(3_fx) == 5_fx);
+  static_assert(!FIntMax.CheckedAdd(kEpsilon));
+  static_assert(!FIntMin.CheckedAdd(-kEpsilon));
+  static_assert(*(2_fx).CheckedSub(3_fx) == -1_fx);
+  static_assert(!FIntMin.CheckedSub(kEpsilon));
+  static_assert(!FInt().CheckedSub(FIntMin));
+  static_assert(*(-2_fx).CheckedMul(FInt::FromFraction(3, 2)) == -3_fx);
+  static_assert(*FIntMax.CheckedMul(kEpsilon) == FIntMax / 4096);
+  static_assert(!FIntMax.CheckedMul(2_fx));
+  static_assert(*(3_fx).CheckedDiv(-2_fx) == -FInt::FromFraction(3, 2));
+  static_assert(!(3_fx).CheckedDiv(FInt()));
+  static_assert(!FIntMax.CheckedDiv(FInt::FromFraction(1, 2)));
+
+  static_assert((2_fx).SaturatingAdd(3_fx) == 5_fx);
+  static_assert(FIntMax.SaturatingAdd(kEpsilon) == FIntMax);
+  static_assert(FIntMin.SaturatingAdd(-kOne) == FIntMin);
+  static_assert(FIntMin.SaturatingSub(kOne) == FIntMin);
+  static_assert(FIntMax.SaturatingSub(-kOne) == FIntMax);
+  static_assert(FInt().SaturatingSub(FIntMin) == FIntMax);
+  static_assert(FIntMax.SaturatingMul(2_fx) == FIntMax);
+  static_assert(FIntMax.SaturatingMul(-2_fx) == FIntMin);
+  static_assert(FIntMin.SaturatingMul(-kOne) == FIntMax);
+  static_assert(FIntMin.SaturatingDiv(-kOne) == FIntMax);
+  static_assert(FIntMax.SaturatingDiv(-kEpsilon) == FIntMin);
+  // The intermediate results of the saturating functions do not overflow.
+  static_assert(FInt::FromInt(5000000).SaturatingMul(FInt::FromInt(5000000)) ==
+                FInt::FromInt(5000000) * 5000000);
+  static_assert(FInt::FromInt(2000000000).SaturatingDiv(FInt::FromInt(4)) ==
+                FInt::FromInt(500000000));
+
+  // Same as the operators when the operations do not overflow.
+  std::mt19937_64 rng(13);
+  std::uniform_int_distribution<int64_t> uid(-(1LL << 31), 1LL << 31);
+  for (int i = 0; i < 10000; i++) {
+    FInt a = FInt::FromRawValue(uid(rng));
+    FInt b = FInt::FromRawValue(uid(rng) | 1);
+    assert(*a.CheckedAdd(b) == a + b);
+    assert(*a.CheckedSub(b) == a - b);
+    assert(*a.CheckedMul(b) == a * b);
+    assert(*a.CheckedDiv(b) == a / b);
+    assert(a.SaturatingAdd(b) == a + b);
+    assert(a.SaturatingSub(b) == a - b);
+    assert(a.SaturatingMul(b) == a * b);
+    assert(a.SaturatingDiv(b) == a / b);
+  }
+
+  // The intermediate results of the operators overflow, unless
+  // DUX_FIXED_WIDE_ARITHMETIC is defined.
+  FInt big = FInt::FromInt(5000000);
+  FInt huge = FInt::FromRawValue(1LL << 52);
+#if defined(DUX_FIXED_WIDE_ARITHMETIC)
+  assert(big.CheckedMul(big) == big * 5000000);
+  assert(huge.CheckedDiv(kOne) == huge);
+#else
+  assert(!big.CheckedMul(big));
+  assert(!huge.CheckedDiv(kOne));
+#endif
+
+  // Unsigned divisors, which are never -1 once converted unless they are as
+  // wide as the raw values.
+  constexpr uint32_t kUint32Max = std::numeric_limits<uint32_t>::max();
+  assert(FIntMin / kUint32Max ==
+         FInt::FromRawValue(FIntMin.raw_value_ / int64_t(kUint32Max)));
+  assert(FIntMin / uint64_t(2) == FIntMin / 2);
+  static_assert(FIntMax / kUint32Max ==
+                FInt::FromRawValue(FIntMax.raw_value_ / int64_t(kUint32Max)));
+
+  // 32-bit numbers.
+  using Q16 = Fixed<int32_t, 16>;
+  static_assert(*Q16::FromInt(100).CheckedMul(Q16::FromInt(300)) ==
+                Q16::FromInt(30000));
+  static_assert(!Q16::FromInt(200).CheckedMul(Q16::FromInt(200)));
+  static_assert(!Q16::FromInt(20000).CheckedDiv(Q16::FromFraction(1, 2)));
+  static_assert(Q16::FromInt(200).SaturatingMul(Q16::FromInt(-200)) ==
+                Q16::FromRawValue(std::numeric_limits<int32_t>::min()));
+  static_assert(Q16::FromInt(-20000).SaturatingDiv(Q16::FromFraction(-1, 2)) ==
+                Q16::FromRawValue(std::numeric_limits<int32_t>::max()));
+}
+
+// Test that |InvSqrt| is within one unit of the exact inverse square root.
+template <typename F>
+void TestInvSqrt() {
+  using RawType = typename F::RawType;
+  assert(F::FromInt(1).InvSqrt() == F::FromInt(1));
+  assert(F::FromInt(4).InvSqrt() == F::FromFraction(1, 2));
+  assert(F::FromFraction(1, 4).InvSqrt() == F::FromInt(2));
+  assert(F::FromInt(64).InvSqrt() == F::FromFraction(1, 8));
+  std::mt19937_64 generator(7);
+  for (int i = 0; i < 100000; i++) {
+    // Positive values of any magnitude.
+    constexpr int kBits = sizeof(RawType) * 8;
+    RawType raw_value = static_cast<RawType>(
+        generator() >> (64 - kBits + 1 + generator() % (kBits - 1)));
+    if (raw_value <= 0) {
+      continue;
+    }
+    F v = F::FromRawValue(raw_value);
+    double expected = 1 / std::sqrt(v.DoubleValue());
+    assert(std::abs(v.InvSqrt().DoubleValue() - expected) <=
+           1.0 / (int64_t(1) << F::kShift));
+  }
+  assert(F::FromRawValue(1).InvSqrt() ==
+         F::FromRawValue(RawType(1) << (F::kShift + F::kHalfShift)));
+}
+
+// Test that |FastExp|, |FastLn| and |FastPow| are within the documented
+// errors.
+template <typename F>
+void TestFastExpLnPow() {
+  using RawType = typename F::RawType;
+  double const unit = 1.0 / (int64_t(1) << F::kShift);
+  double const max = std::numeric_limits<RawType>::max() * unit;
+  F const f_max = F::FromRawValue(std::numeric_limits<RawType>::max());
+  assert(FastExp(F()) == F::FromInt(1));
+  assert(FastLn(F::FromInt(1)) == F());
+  assert(FastPow(F::FromInt(2), F::FromInt(10)) == F::FromInt(1024));
+  assert(FastPow(F::FromInt(-2), F::FromInt(3)) == F::FromInt(-8));
+  assert(FastPow(F::FromInt(-2), F::FromInt(4)) == F::FromInt(16));
+  assert(FastPow(F::FromInt(4), F::FromFraction(1, 2)) == F::FromInt(2));
+  assert(FastPow(F::FromInt(4), F::FromInt(-1)) == F::FromFraction(1, 4));
+  assert(FastPow(F::FromInt(7), F()) == F::FromInt(1));
+  assert(FastPow(F(), F::FromInt(7)) == F());
+  // Saturation.
+  assert(FastExp(F::FromInt(100)) == f_max);
+  assert(FastExp(F::FromInt(-100)) == F());
+  assert(FastPow(F::FromInt(10), F::FromInt(100)) == f_max);
+  assert(FastPow(F::FromInt(10), F::FromInt(-100)) == F());
+
+  std::mt19937_64 generator(11);
+  double const log_max = std::log(max);
+  for (int i = 0; i < 20000; i++) {
+    F x = F::FromDouble(std::uniform_real_distribution<double>(
+        -log_max - 1, log_max - 0.01)(generator));
+    double expected = std::exp(x.DoubleValue());
+    assert(std::abs(FastExp(x).DoubleValue() - expected) <=
+           unit + expected * std::ldexp(1, -28));
+  }
+  for (int i = 0; i < 20000; i++) {
+    constexpr int kBits = sizeof(RawType) * 8;
+    RawType raw_value = static_cast<RawType>(
+        generator() >> (64 - kBits + 1 + generator() % (kBits - 1)));
+    if (raw_value <= 0) {
+      continue;
+    }
+    F x = F::FromRawValue(raw_value);
+    assert(std::abs(FastLn(x).DoubleValue() - std::log(x.DoubleValue())) <=
+           unit);
+  }
+  for (int i = 0; i < 20000; i++) {
+    F x = F::FromDouble(
+        std::uniform_real_distribution<double>(0.01, 100)(generator));
+    F y = F::FromDouble(
+        std::uniform_real_distribution<double>(-4, 4)(generator));
+    double exponent = y.DoubleValue() * std::log2(x.DoubleValue());
+    double expected = std::pow(x.DoubleValue(), y.DoubleValue());
+    if (expected >= max) {
+      continue;
+    }
+    assert(std::abs(FastPow(x, y).DoubleValue() - expected) <=
+           unit + expected * std::ldexp(1, -26) * (1 + std::abs(exponent)));
+  }
+}
+
+// Test that |Fixed::Sqrt|, |Exp|, |Ln| and |Pow| can be evaluated at compile
+// time, with the same results as at run time.
+void TestConstexprFunctions() {
+  static_assert((16_fx).Sqrt() == 4_fx);
+  static_assert(FIntMax.Sqrt() > 46000000_fx);
+  static_assert(Exp(FInt()) == 1_fx);
+  static_assert(Ln(1_fx) == FInt());
+  static_assert(Pow(2_fx, 10_fx) == 1024_fx);
+  static_assert(Pow(FInt::FromFraction(1, 4), -2_fx) == 16_fx);
+  static_assert(InterpolateAngle(1_fx, -1_fx, 1_fx / 2_fx) == 0_fx);
+
+  // A curve computed at compile time.
+  constexpr size_t kCount = 64;
+  constexpr std::array<FInt, kCount> kCurve = [] {
+    std::array<FInt, kCount> curve = {};
+    for (size_t i = 0; i < kCount; i++) {
+      FInt x = FInt::FromFraction(static_cast<int32_t>(i), 8);
+      curve[i] = Exp(-x) + Ln(x + 1_fx) +
+                 Pow(x, FInt::FromFraction(3, 2)) + x.Sqrt();
+    }
+    return curve;
+  }();
+  for (size_t i = 0; i < kCount; i++) {
+    FInt x = FInt::FromFraction(static_cast<int32_t>(i), 8);
+    assert(kCurve[i] == Exp(-x) + Ln(x + 1_fx) +
+                            Pow(x, FInt::FromFraction(3, 2)) + x.Sqrt());
+  }
+}
+
+}  // namespace
+
 void TestFInt() {
   // Test |FromInt|, |FromRawValue|, |FromDouble|.
   assert(FInt::FromInt(12).raw_value_ == 12 << FInt::kShift);
@@ -125,6 +530,16 @@ void TestFInt() {
         static_cast<double>(sqrtf(static_cast<float>(v.DoubleValue()))),
         v.Sqrt(), 2.01);
   }
+  TestSqrtMatchesLegacySqrt();
+  TestInvSqrt<FInt>();
+  TestInvSqrt<Fixed<int64_t, 16>>();
+  TestInvSqrt<FInt32>();
+  TestFastExpLnPow<FInt>();
+  TestFastExpLnPow<Fixed<int64_t, 16>>();
+  TestFastExpLnPow<Fixed<int64_t, 20>>();
+  TestFastExpLnPow<FInt32>();
+  TestFastExpLnPow<Fixed<int32_t, 16>>();
+  TestConstexprFunctions();
 
   // Test |Exp|.
   // Test 800 values in the [0, 8] range.
@@ -306,12 +721,26 @@ void TestFInt() {
   // Test constants.
   assert(FIntMax > 10000000_fx);
   assert(FIntMin < -10000000_fx);
+#if defined(__clang__)
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Winteger-overflow"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverflow"
+#endif
   assert(FIntMax.raw_value_ + 1 == FIntMin.raw_value_);
+#if defined(__clang__)
 #pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
   AssertNearlyEqual(FIntQuarterPi.DoubleValue() * 2, FIntHalfPi);
   AssertNearlyEqual(FIntHalfPi.DoubleValue() * 2, FIntPi);
   AssertNearlyEqual(FIntPi.DoubleValue() * 2, FIntTwoPi);
   AssertNearlyEqual(3.14159, FIntPi);
+
+  TestFixedPrecisions();
+  TestFInt32();
+  TestWideArithmetic();
+  TestOverflowHandling();
 }
@@ -1,14 +1,403 @@
 #include "test_fixed_trig.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <random>
+#include <vector>
 
+#include "fixed_batch.h"
+#include "fixed_trig_table.h"
 #include "utils.h"
 
 using namespace dux;
 using namespace dux::trig;
 using namespace dux_test_utils;
 
+namespace {
+
+// Normalizes |angle| with divisions.
+FInt DivisionNormalizeAngle(FInt angle) {
+  if (angle < 0_fx) {
+    return FIntTwoPi - (-angle) % FIntTwoPi;
+  } else if (angle > FIntTwoPi) {
+    return angle % FIntTwoPi;
+  }
+  return angle;
+}
+
+// Test that |CosTableIndex| and |NormalizeAngle| give the same results as
+// the divisions they replace.
+void TestDivisionFreeAngleReduction() {
+  static_assert(CosTableIndex(0_fx) == 0);
+  static_assert(CosTableIndex(FIntHalfPi) == 512);
+  static_assert(NormalizeAngle(-FIntTwoPi) == FIntTwoPi);
+  static_assert(NormalizeAngle(FIntTwoPi + FIntPi) == FIntPi);
+
+  for (int64_t raw = 0; raw <= FIntTwoPi.raw_value_; raw++) {
+    FInt angle = FInt::FromRawValue(raw);
+    assert(CosTableIndex(angle) ==
+           static_cast<uint32_t>(
+               ((angle * 512) / FIntHalfPi).Round().Int32()));
+  }
+
+  std::vector<int64_t> raw_angles;
+  for (int64_t raw = -3 * FIntTwoPi.raw_value_;
+       raw <= 3 * FIntTwoPi.raw_value_; raw++) {
+    raw_angles.push_back(raw);
+  }
+  for (int64_t offset = -100000; offset <= 100000; offset++) {
+    raw_angles.push_back(kAngleReductionLimit + offset);
+    raw_angles.push_back(-kAngleReductionLimit + offset);
+  }
+  std::mt19937_64 rng(3);
+  std::uniform_int_distribution<int64_t> uid(-FIntMax.raw_value_,
+                                             FIntMax.raw_value_);
+  for (int i = 0; i < 100000; i++) {
+    raw_angles.push_back(uid(rng));
+    raw_angles.push_back(uid(rng) >> 30);
+  }
+  for (int64_t raw : raw_angles) {
+    FInt angle = FInt::FromRawValue(raw);
+    assert(NormalizeAngle(angle) == DivisionNormalizeAngle(angle));
+  }
+
+  // The branchless |Sincos| and the branchy |Cos| must agree.
+  for (int64_t raw = -3 * FIntTwoPi.raw_value_;
+       raw <= 3 * FIntTwoPi.raw_value_; raw++) {
+    FInt angle = FInt::FromRawValue(raw);
+    FInt sin;
+    FInt cos;
+    Sincos(angle, sin, cos);
+    assert(cos == Cos(angle));
+  }
+}
+
+void AssertSincosNMatchesSincos(std::vector<FInt> const& angles) {
+  std::vector<FInt> sin(angles.size());
+  std::vector<FInt> cos(angles.size());
+  SincosN(angles.data(), sin.data(), cos.data(), angles.size());
+  for (size_t i = 0; i < angles.size(); i++) {
+    FInt expected_sin;
+    FInt expected_cos;
+    Sincos(angles[i], expected_sin, expected_cos);
+    assert(sin[i] == expected_sin);
+    assert(cos[i] == expected_cos);
+  }
+}
+
+// Test that |SincosN| gives the same results as |Sincos| with every backend.
+void TestSincosN() {
+  std::vector<FInt> angles;
+  // Every angle in [-3*2*PI, 3*2*PI].
+  for (int64_t raw = -3 * FIntTwoPi.raw_value_;
+       raw <= 3 * FIntTwoPi.raw_value_; raw++) {
+    angles.push_back(FInt::FromRawValue(raw));
+  }
+  // Angles around the limit of the multiplication-based range reduction, and
+  // at the limits of |FInt|.
+  for (int64_t limit : {int64_t(1) << 31, FIntMax.raw_value_}) {
+    for (int64_t offset = -1000; offset <= 0; offset++) {
+      angles.push_back(FInt::FromRawValue(limit + offset));
+      angles.push_back(FInt::FromRawValue(-limit - offset));
+    }
+  }
+  std::mt19937_64 rng(5);
+  std::uniform_int_distribution<int64_t> uid(-FIntMax.raw_value_,
+                                             FIntMax.raw_value_);
+  std::uniform_int_distribution<int64_t> small_uid(-(int64_t(1) << 32),
+                                                   int64_t(1) << 32);
+  for (int i = 0; i < 100000; i++) {
+    angles.push_back(FInt::FromRawValue(uid(rng)));
+    angles.push_back(FInt::FromRawValue(small_uid(rng)));
+  }
+
+  batch::Backend default_backend = batch::ActiveBackend();
+  for (batch::Backend backend : {batch::Backend::kScalar,
+                                 batch::Backend::kSse42,
+                                 batch::Backend::kAvx2}) {
+    if (!batch::IsBackendSupported(backend)) {
+      continue;
+    }
+    batch::SetActiveBackend(backend);
+    AssertSincosNMatchesSincos(angles);
+    // Sizes that leave angles for the scalar tail.
+    for (size_t count : {0, 1, 2, 3, 5, 6, 7}) {
+      AssertSincosNMatchesSincos(
+          std::vector<FInt>(angles.end() - count, angles.end()));
+    }
+  }
+  batch::SetActiveBackend(default_backend);
+}
+
+// Returns the largest error of |Trig| over all the angles in [0, 2*PI].
+template <typename Trig>
+double MaxError() {
+  double max_error = 0;
+  for (int64_t raw = 0; raw <= FIntTwoPi.raw_value_; raw++) {
+    FInt angle = FInt::FromRawValue(raw);
+    FInt sin;
+    FInt cos;
+    Trig::Sincos(angle, sin, cos);
+    assert(cos == Trig::Cos(angle));
+    max_error = std::max(max_error,
+                         std::abs(cos.DoubleValue() - std::cos(angle.DoubleValue())));
+    max_error = std::max(max_error,
+                         std::abs(sin.DoubleValue() - std::sin(angle.DoubleValue())));
+  }
+  return max_error;
+}
+
+template <uint32_t kSegments>
+void TestCosTable() {
+  for (uint32_t i = 0; i <= kSegments; i++) {
+    double expected = std::cos(i * (M_PI / (2 * kSegments)));
+    assert(CosTable<kSegments>::kValues[i] ==
+           std::llround(expected * (1 << kCosTableShift)));
+  }
+  // The error of the nearest entry is at most half a segment, plus the
+  // truncation to |FInt|. The error of the interpolation is at most
+  // segment^2 / 8, plus the rounding of the table and of the result.
+  double segment = M_PI / (2 * kSegments);
+  double fint_unit = 1.0 / (1 << FInt::kShift);
+  // The angles themselves are rounded to |FInt|.
+  double angle_error = fint_unit / 2;
+  using NearestTrig = TableTrig<kSegments, Interpolation::kNearest>;
+  using LinearTrig = TableTrig<kSegments, Interpolation::kLinear>;
+  assert(MaxError<NearestTrig>() <= segment / 2 + angle_error + fint_unit);
+  assert(MaxError<LinearTrig>() <=
+         segment * segment / 8 + angle_error + fint_unit);
+}
+
+// Test the tables generated at compile time, and |TableTrig|.
+void TestTableTrig() {
+  static_assert(TableTrig<1024, Interpolation::kLinear>::Cos(0_fx) == 1_fx);
+  static_assert(TableTrig<256, Interpolation::kNearest>::Sin(FIntPi) == 0_fx);
+
+  // The default table matches the one printed by the original
+  // |GenerateLookupTables| with std::cos.
+  for (int i = 0; i <= 512; i++) {
+    FInt expected = FInt::FromDouble(std::cos(i * (M_PI / 1024)));
+    assert(FInt::FromRawValue(CosTable<512>::kValues[i] >>
+                              (kCosTableShift - FInt::kShift)) == expected);
+  }
+
+  using DefaultTrig = TableTrig<512, Interpolation::kNearest>;
+  for (int64_t raw = -3 * FIntTwoPi.raw_value_;
+       raw <= 3 * FIntTwoPi.raw_value_; raw++) {
+    FInt angle = FInt::FromRawValue(raw);
+    assert(DefaultTrig::Cos(angle) == Cos(angle));
+    assert(DefaultTrig::Sin(angle) == Sin(angle));
+    FInt sin;
+    FInt cos;
+    FInt expected_sin;
+    FInt expected_cos;
+    DefaultTrig::Sincos(angle, sin, cos);
+    Sincos(angle, expected_sin, expected_cos);
+    assert(sin == expected_sin);
+    assert(cos == expected_cos);
+  }
+
+  TestCosTable<256>();
+  TestCosTable<512>();
+  TestCosTable<1024>();
+  TestCosTable<4096>();
+}
+
+// The original |Atan2|, which binary searched a table of tan values.
+FInt LegacyAtan2(FInt y, FInt x) {
+  static std::vector<int32_t> const tan_table = [] {
+    std::vector<int32_t> table;
+    for (int i = 0; i < 512; i++) {
+      double angle = i * (2 * M_PI / 512);
+      table.push_back(
+          static_cast<int32_t>(FInt::FromDouble(std::tan(angle / 4)).raw_value_));
+    }
+    return table;
+  }();
+  if (x.raw_value_ == 0) {
+    if (y.raw_value_ > 0) {
+      return FIntHalfPi;
+    } else {
+      return FIntPi + FIntHalfPi;
+    }
+  }
+  int32_t d = static_cast<uint32_t>((y / x).raw_value_);
+  d = std::abs(d);
+  int32_t index = static_cast<int32_t>(
+      std::upper_bound(tan_table.begin(), tan_table.end(), d) -
+      tan_table.begin()) - 1;
+  index = std::max(index, 0);
+  FInt angle = FIntHalfPi * FInt::FromInt(index);
+  angle >>= 9;
+  if (y.raw_value_ > 0) {
+    if (x.raw_value_ > 0) {
+      return angle;
+    } else {
+      return FIntPi - angle;
+    }
+  } else {
+    if (x.raw_value_ > 0) {
+      if (angle == 0_fx) {
+        return 0_fx;
+      }
+      return FIntTwoPi - angle;
+    } else {
+      return FIntPi + angle;
+    }
+  }
+}
+
+// Returns the error of |angle| as the arc tangent of y/x, in units of the
+// smallest |FInt|.
+double Atan2Error(FInt angle, FInt y, FInt x) {
+  double expected = std::atan2(static_cast<double>(y.raw_value_),
+                               static_cast<double>(x.raw_value_));
+  double error = std::abs(angle.DoubleValue() - expected);
+  // The angles near 0 may be returned near 2*PI.
+  error = std::min(error, std::abs(error - 2 * M_PI));
+  return error * (1 << FInt::kShift);
+}
+
+// Test the accuracy of |Atan2|, including against the original version.
+void TestAtan2Accuracy() {
+  for (uint32_t i = 0; i <= 256; i++) {
+    double expected = std::atan(i / 256.0) * (1 << kAtanTableShift);
+    assert(std::abs(AtanTable<256>::kValues[i] - expected) <= 0.5 + 1e-6);
+  }
+
+  double max_error = 0;
+  double max_legacy_error = 0;
+  for (int x = -1000; x <= 1000; x += 7) {
+    for (int y = -1000; y <= 1000; y += 3) {
+      if (x == 0) {
+        continue;
+      }
+      FInt fx = FInt::FromRawValue(x * 37);
+      FInt fy = FInt::FromRawValue(y * 41);
+      FInt angle = Atan2(fy, fx);
+      assert(angle >= 0_fx && angle < FIntTwoPi);
+      max_error = std::max(max_error, Atan2Error(angle, fy, fx));
+      max_legacy_error =
+          std::max(max_legacy_error, Atan2Error(LegacyAtan2(fy, fx), fy, fx));
+    }
+  }
+  // Rounding to |FInt|, plus the rounding of the pi constants.
+  assert(max_error < 0.6);
+  assert(max_legacy_error > 4 * max_error);
+
+  // Steep ratios, large and extreme values.
+  std::mt19937_64 rng(11);
+  std::vector<int64_t> values = {1, 2, 3, 4095, 4096, 1LL << 40, 1LL << 52,
+                                 FIntMax.raw_value_, FIntMin.raw_value_};
+  for (int i = 0; i < 300; i++) {
+    values.push_back(static_cast<int64_t>(rng()) >> (rng() % 63));
+  }
+  for (int64_t raw_x : values) {
+    for (int64_t raw_y : values) {
+      for (int64_t x_sign : {1, -1}) {
+        for (int64_t y_sign : {1, -1}) {
+          if ((x_sign < 0 && raw_x == FIntMin.raw_value_) ||
+              (y_sign < 0 && raw_y == FIntMin.raw_value_) || raw_x == 0) {
+            continue;
+          }
+          FInt fx = FInt::FromRawValue(raw_x * x_sign);
+          FInt fy = FInt::FromRawValue(raw_y * y_sign);
+          FInt angle = Atan2(fy, fx);
+          assert(angle >= 0_fx && angle < FIntTwoPi);
+          assert(Atan2Error(angle, fy, fx) < 1);
+        }
+      }
+    }
+  }
+}
+
+// Test the trigonometry of the precisions other than |FInt|.
+template <typename F>
+void TestPrecisionTrig() {
+  double unit = 1.0 / (1 << F::kShift);
+  // Half a segment of the default table, plus the truncation.
+  double table_error = M_PI / (4 * 512) + 2 * unit;
+  for (double a = -10; a < 10; a += 0.001) {
+    F angle = F::FromDouble(a);
+    double expected_cos = std::cos(angle.DoubleValue());
+    double expected_sin = std::sin(angle.DoubleValue());
+    assert(std::abs(Cos(angle).DoubleValue() - expected_cos) <= table_error);
+    assert(std::abs(Sin(angle).DoubleValue() - expected_sin) <= table_error);
+    F sin;
+    F cos;
+    Sincos(angle, sin, cos);
+    assert(cos == Cos(angle));
+    assert(sin == Sin(angle));
+  }
+
+  using LinearTrig = TableTrig<4096, Interpolation::kLinear, F>;
+  for (double a = 0; a < 7; a += 0.001) {
+    F angle = F::FromDouble(a);
+    assert(std::abs(LinearTrig::Cos(angle).DoubleValue() -
+                    std::cos(angle.DoubleValue())) <= 2 * unit);
+  }
+
+  // The interpolation error of the arc tangent table, plus the roundings.
+  double atan_error = 1.0 / (8 * kAtanSegments * kAtanSegments) + 2 * unit;
+  std::mt19937 rng(5);
+  std::uniform_int_distribution<int> uid(-30000, 30000);
+  for (int i = 0; i < 10000; i++) {
+    F y = F::FromFraction(uid(rng), 1000);
+    F x = F::FromFraction(uid(rng), 1000);
+    if (y == F() && x == F()) {
+      continue;
+    }
+    F angle = Atan2(y, x);
+    assert(angle >= F());
+    assert(angle < FixedTwoPi<F>);
+    double expected = std::atan2(y.DoubleValue(), x.DoubleValue());
+    if (expected < 0) {
+      expected += 2 * M_PI;
+    }
+    double error = std::abs(angle.DoubleValue() - expected);
+    // Around 0, the result may be on the other side of the cut.
+    error = std::min(error, std::abs(error - 2 * M_PI));
+    assert(error <= atan_error);
+  }
+}
+
+// Test that |Cos|, |Sin|, |Sincos| and |Atan2| can be evaluated at compile
+// time, with the same results as at run time.
+void TestConstexprTrig() {
+  static_assert(Cos(0_fx) == 1_fx);
+  static_assert(Sin(FIntHalfPi) == 1_fx);
+  static_assert(Cos(FIntPi) == -1_fx);
+  static_assert(Atan2(1_fx, 0_fx) == FIntHalfPi);
+  static_assert(Atan2(1_fx, 1_fx) == FIntQuarterPi);
+
+  // A table of rotations computed at compile time.
+  constexpr size_t kCount = 64;
+  struct Rotation {
+    FInt sin;
+    FInt cos;
+    FInt angle;
+  };
+  constexpr std::array<Rotation, kCount> kRotations = [] {
+    std::array<Rotation, kCount> rotations = {};
+    for (size_t i = 0; i < kCount; i++) {
+      FInt angle = FIntTwoPi * static_cast<int32_t>(i) / kCount;
+      Sincos(angle, rotations[i].sin, rotations[i].cos);
+      rotations[i].angle = Atan2(rotations[i].sin, rotations[i].cos);
+    }
+    return rotations;
+  }();
+  for (size_t i = 0; i < kCount; i++) {
+    FInt angle = FIntTwoPi * static_cast<int32_t>(i) / kCount;
+    assert(kRotations[i].sin == Sin(angle));
+    assert(kRotations[i].cos == Cos(angle));
+    assert(kRotations[i].angle == Atan2(Sin(angle), Cos(angle)));
+  }
+}
+
+}  // namespace
+
 void TestTrig() {
   // Test |Sin|, |Cos|, |Sincos|.
   for (double a = -10; a < 10; a += 0.001) {
@@ -24,6 +413,14 @@ void TestTrig() {
     AssertNearlyEqual(expectedSin, sin);
   }
 
+  TestDivisionFreeAngleReduction();
+  TestTableTrig();
+  TestSincosN();
+  TestAtan2Accuracy();
+  TestConstexprTrig();
+  TestPrecisionTrig<Fixed<int64_t, 20>>();
+  TestPrecisionTrig<Fixed<int32_t, 16>>();
+
   // Test |Atan2|.
   for (double x = -10; x < 10; x += 1) {
     for (double y = -10; y < 10; y += 1) {
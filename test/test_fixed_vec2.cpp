@@ -1,6 +1,8 @@
 #include "test_fixed_vec2.h"
 
 #include <cmath>
+#include <random>
+#include <vector>
 
 #include "utils.h"
 
@@ -48,6 +50,54 @@ void TestFVec2() {
   AssertNearlyEqual(-sqrt(0.5), v3.x_);
   AssertNearlyEqual(sqrt(0.5), v3.y_);
 
+  // Test that |Normalize| is within one unit of the exact result, and that
+  // |NormalizeWithDivision| divides by |Length|.
+  std::mt19937 generator(3);
+  std::uniform_int_distribution<int64_t> distribution(-(int64_t(1) << 40),
+                                                      int64_t(1) << 40);
+  for (int i = 0; i < 10000; i++) {
+    FVec2 v(FInt::FromRawValue(distribution(generator) >> (i % 40)),
+            FInt::FromRawValue(distribution(generator) >> (i % 40)));
+    if (v.x_.raw_value_ == 0 && v.y_.raw_value_ == 0) {
+      continue;
+    }
+    double length = std::hypot(v.x_.DoubleValue(), v.y_.DoubleValue());
+    for (FInt new_length : {1_fx, 10_fx, -3_fx, FInt::FromFraction(1, 7)}) {
+      FVec2 fused = v;
+      fused.Normalize(normalized, new_length);
+      assert(normalized);
+      double scale = new_length.DoubleValue() / length;
+      AssertNearlyEqual(v.x_.DoubleValue() * scale, fused.x_, 1.0 / 4096);
+      AssertNearlyEqual(v.y_.DoubleValue() * scale, fused.y_, 1.0 / 4096);
+    }
+    FVec2 unit = v;
+    unit.Normalize(normalized);
+    assert(v.Normalized() == unit);
+
+    // |Length| overflows for larger components.
+    if (std::abs(v.x_.raw_value_) >= (int64_t(1) << 30) ||
+        std::abs(v.y_.raw_value_) >= (int64_t(1) << 30)) {
+      continue;
+    }
+    FVec2 divided = v;
+    divided.NormalizeWithDivision(normalized);
+    assert(normalized);
+    FInt l = v.Length();
+    assert(divided == FVec2(v.x_ / l, v.y_ / l));
+  }
+  assert(dux::FVec2(0, 0).Normalized() == dux::FVec2(0, 0));
+  dux::FVec2(0, 0).NormalizeWithDivision(normalized);
+  assert(normalized == false);
+  dux::FVec2 v4(10, 0);
+  v4.Normalize(normalized, 3_fx);
+  assert(normalized == true);
+  assert(dux::FVec2(3, 0) == v4);
+  // 3 / 10 is truncated before the multiplication.
+  dux::FVec2 v5(10, 0);
+  v5.NormalizeWithDivision(normalized, 3_fx);
+  assert(normalized == true);
+  assert(dux::FVec2(10_fx * (3_fx / 10_fx), 0_fx) == v5);
+
   // Test |FromAngle|.
   for (double float_angle = -10; float_angle < 20; float_angle += 0.01) {
     FInt angle = FInt::FromDouble(float_angle);
@@ -95,5 +145,21 @@ void TestFVec2() {
   assert(dux::FVec2(1, 1) >= dux::FVec2(0, 0));
   assert(dux::FVec2(1, 0) >= dux::FVec2(0, 0));
 
+  // Test |FromAngles|.
+  std::vector<dux::FInt> angles;
+  for (int i = -2000; i < 2000; i++) {
+    angles.push_back(dux::FInt::FromRawValue(i * 37));
+  }
+  std::vector<dux::FVec2> vectors(angles.size());
+  dux::FVec2::FromAngles(angles.data(), vectors.data(), angles.size());
+  for (size_t i = 0; i < angles.size(); i++) {
+    assert(vectors[i] == dux::FVec2::FromAngle(angles[i]));
+  }
+  dux::FVec2::FromAngles(angles.data(), 7_fx / 3_fx, vectors.data(),
+                         angles.size());
+  for (size_t i = 0; i < angles.size(); i++) {
+    assert(vectors[i] == dux::FVec2::FromAngle(angles[i], 7_fx / 3_fx));
+  }
+
   // TODO: test everything.
 }
@@ -0,0 +1,158 @@
+#include "test_fixed_vec2_array.h"
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include "fixed_batch.h"
+#include "fixed_vec2_array.h"
+#include "utils.h"
+
+using namespace dux;
+using namespace dux_test_utils;
+
+namespace {
+
+// Returns vectors of every magnitude handled by |FVec2::Length|, including
+// null and very short ones.
+std::vector<FVec2> TestVectors(size_t count) {
+  std::vector<FVec2> vectors;
+  FInt tiny = FInt::FromFraction(1, 10);
+  for (size_t i = 0; vectors.size() < count; i++) {
+    switch (i % 5) {
+      case 0:
+        vectors.push_back(RandFVec2(-tiny, tiny, -tiny, tiny));
+        break;
+      case 1:
+        vectors.push_back(RandFVec2(-10_fx, 10_fx, -10_fx, 10_fx));
+        break;
+      case 2:
+        vectors.push_back(
+            RandFVec2(-500000_fx, 500000_fx, -500000_fx, 500000_fx));
+        break;
+      case 3:
+        vectors.push_back(RandFVec2(-tiny, tiny, 1_fx, 2_fx));
+        break;
+      default:
+        vectors.push_back(i % 2 ? FVec2(0, 0) : FVec2(0, 3));
+        break;
+    }
+  }
+  return vectors;
+}
+
+FVec2Array ToArray(std::vector<FVec2> const& vectors) {
+  FVec2Array array;
+  for (FVec2 const& v : vectors) {
+    array.PushBack(v);
+  }
+  return array;
+}
+
+void TestPasses(size_t count) {
+  std::vector<FVec2> vectors = TestVectors(count);
+  std::vector<FVec2> others = TestVectors(count + 3);
+  others.erase(others.begin(), others.begin() + 3);
+  FVec2Array array = ToArray(vectors);
+  FVec2Array other_array = ToArray(others);
+  assert(array.Size() == count);
+  for (size_t i = 0; i < count; i++) {
+    assert(array.Get(i) == vectors[i]);
+  }
+
+  std::vector<FInt> out(count);
+  array.SquareLength(out.data());
+  for (size_t i = 0; i < count; i++) {
+    assert(out[i] == vectors[i].SquareLength());
+  }
+  array.Length(out.data());
+  for (size_t i = 0; i < count; i++) {
+    FVec2 v = vectors[i];
+    assert(out[i] == v.Length());
+  }
+  array.DotProduct(other_array, out.data());
+  for (size_t i = 0; i < count; i++) {
+    assert(out[i] == vectors[i].DotProduct(others[i]));
+  }
+
+  FVec2Array normalized = array;
+  std::unique_ptr<bool[]> success(new bool[count + 1]);
+  normalized.Normalize(success.get());
+  for (size_t i = 0; i < count; i++) {
+    FVec2 v = vectors[i];
+    bool expected_success;
+    v.Normalize(expected_success);
+    assert(normalized.Get(i) == v);
+    assert(success[i] == expected_success);
+  }
+  normalized = array;
+  normalized.Normalize(nullptr);
+  for (size_t i = 0; i < count; i++) {
+    FVec2 v = vectors[i];
+    bool expected_success;
+    v.Normalize(expected_success);
+    assert(normalized.Get(i) == v);
+  }
+
+  normalized = array;
+  normalized.NormalizeWithDivision(success.get());
+  for (size_t i = 0; i < count; i++) {
+    FVec2 v = vectors[i];
+    bool expected_success;
+    v.NormalizeWithDivision(expected_success);
+    assert(normalized.Get(i) == v);
+    assert(success[i] == expected_success);
+  }
+
+  for (FInt angle : {0_fx, 1_fx, -3_fx, FIntPi, 100_fx}) {
+    FVec2Array rotated = array;
+    rotated.Rotate(angle);
+    for (size_t i = 0; i < count; i++) {
+      FVec2 v = vectors[i];
+      v.Rotate(angle);
+      assert(rotated.Get(i) == v);
+    }
+  }
+
+  FVec2Array velocities = array;
+  velocities.Rotate(2_fx);
+  for (FInt dt : {FInt::FromFraction(1, 60), -1_fx, 3_fx}) {
+    FVec2Array positions = other_array;
+    positions.Integrate(velocities, dt);
+    for (size_t i = 0; i < count; i++) {
+      assert(positions.Get(i) == others[i] + velocities.Get(i) * dt);
+    }
+  }
+}
+
+}  // namespace
+
+void TestFVec2Array() {
+  // Test |Resize|, |Set|, |Get|, |Clear|.
+  FVec2Array array(3);
+  assert(array.Size() == 3);
+  assert(array.Get(2) == FVec2(0, 0));
+  array.Set(1, FVec2(4, -5));
+  assert(array.Get(1) == FVec2(4, -5));
+  array.Resize(10);
+  assert(array.Size() == 10);
+  assert(array.Get(1) == FVec2(4, -5));
+  assert(array.Get(9) == FVec2(0, 0));
+  array.Clear();
+  assert(array.Size() == 0);
+
+  // Test that the bulk passes match |FVec2| with every backend.
+  batch::Backend default_backend = batch::ActiveBackend();
+  for (batch::Backend backend :
+       {batch::Backend::kScalar, batch::Backend::kSse42,
+        batch::Backend::kAvx2}) {
+    if (!batch::IsBackendSupported(backend)) {
+      continue;
+    }
+    batch::SetActiveBackend(backend);
+    for (size_t count : {0, 1, 5, 255, 256, 257, 1000}) {
+      TestPasses(count);
+    }
+  }
+  batch::SetActiveBackend(default_backend);
+}
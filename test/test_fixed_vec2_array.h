@@ -0,0 +1,6 @@
+#ifndef DUX_FILED_TEST_TEST_FIXED_VEC2_ARRAY_H_
+#define DUX_FILED_TEST_TEST_FIXED_VEC2_ARRAY_H_
+
+void TestFVec2Array();
+
+#endif  // DUX_FILED_TEST_TEST_FIXED_VEC2_ARRAY_H_
@@ -0,0 +1,52 @@
+#include "test_fixed_vec32.h"
+
+#include <cassert>
+#include <vector>
+
+#include "fixed_vec32.h"
+
+using namespace dux;
+
+void TestFVec32() {
+  // Test |Widen|.
+  constexpr FVec2_32 v2(FInt32::FromFraction(-7, 3), FInt32Max);
+  assert(v2.Widen() == FVec2(Widen(v2.x_), Widen(FInt32Max)));
+  static_assert(FVec2_32::NarrowSaturated(v2.Widen()) == v2);
+  FVec3_32 v3(FInt32::FromInt(1), FInt32Min, FInt32::FromFraction(1, 7));
+  assert(v3.Widen() == FVec3(1_fx, Widen(FInt32Min), Widen(v3.z_)));
+  assert(FVec3_32::NarrowSaturated(v3.Widen()) == v3);
+
+  // Test |Narrow| and |NarrowSaturated|.
+  bool success = false;
+  FVec2 in_range(-524287_fx, 524287_fx);
+  assert(FVec2_32::Narrow(in_range, success).Widen() == in_range);
+  assert(success);
+  FVec2 out_of_range(-524289_fx, 3_fx);
+  FVec2_32 narrowed = FVec2_32::Narrow(out_of_range, success);
+  assert(!success);
+  assert(narrowed == FVec2_32(FInt32Min, FInt32::FromInt(3)));
+  assert(FVec2_32::NarrowSaturated(FVec2(524288_fx, -524289_fx)) ==
+         FVec2_32(FInt32Max, FInt32Min));
+
+  FVec3 in_range3(-524288_fx, 0_fx, FInt::FromFraction(5, 3));
+  assert(FVec3_32::Narrow(in_range3, success).Widen() == in_range3);
+  assert(success);
+  FVec3 out_of_range3(1_fx, 2_fx, 1000000_fx);
+  assert(FVec3_32::Narrow(out_of_range3, success) ==
+         FVec3_32(FInt32::FromInt(1), FInt32::FromInt(2), FInt32Max));
+  assert(!success);
+
+  // Round trip of the computations done on the widened values.
+  std::vector<FVec2_32> positions(100);
+  for (size_t i = 0; i < positions.size(); i++) {
+    positions[i] = FVec2_32::NarrowSaturated(FVec2(static_cast<int>(i), -1));
+  }
+  FVec2 velocity(FInt::FromFraction(1, 3), FInt::FromFraction(-1, 5));
+  for (FVec2_32& position : positions) {
+    FVec2 widened = position.Widen();
+    widened += velocity;
+    position = FVec2_32::Narrow(widened, success);
+    assert(success);
+    assert(position.Widen() == widened);
+  }
+}
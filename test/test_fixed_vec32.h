@@ -0,0 +1,6 @@
+#ifndef DUX_FILED_TEST_TEST_FVEC32_H_
+#define DUX_FILED_TEST_TEST_FVEC32_H_
+
+void TestFVec32();
+
+#endif  // DUX_FILED_TEST_TEST_FVEC32_H_
@@ -2,8 +2,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <memory>
+#include <optional>
 
 #include "grid_walking.h"
+#include "thread_pool.h"
 #include "utils.h"
 
 using namespace dux;
@@ -53,6 +57,18 @@ void AssertVecEqual(std::vector<GridPosition> a, std::vector<GridPosition> b) {
   }
 }
 
+std::vector<GridPosition> VisitedPositions(dux::FVec2 start,
+                                           dux::FVec2 end,
+                                           GridSize size) {
+  std::vector<GridPosition> v;
+  bool completed = WalkVisit(start, end, size, [&v](GridPosition p) {
+    v.push_back(p);
+    return true;
+  });
+  assert(completed);
+  return v;
+}
+
 struct WalkVerificationArgs {
   dux::FVec2 start_;
   dux::FVec2 end_;
@@ -107,6 +123,13 @@ void VerifyWalk(WalkVerificationArgs args) {
     steps *= 2;
   } while (steps < 100000 && computed_expected_results.size() != result.size());
   AssertVecEqual(result, computed_expected_results);
+
+  AssertVecEqual(VisitedPositions(args.start_, args.end_, {9999, 9999}),
+                 result);
+  // Both directions visit the same positions.
+  std::reverse(result.begin(), result.end());
+  AssertVecEqual(VisitedPositions(args.end_, args.start_, {9999, 9999}),
+                 result);
 }
 
 void VerifyWalkAllDirections(dux::FVec2 start, std::pair<int, int> end) {
@@ -135,6 +158,271 @@ void VerifyWalkAllDirections(dux::FVec2 start, std::pair<int, int> end) {
   }
 }
 
+void TestWalkVisit() {
+  // Positions outside of the grid are skipped.
+  for (int i = 0; i < 1000; i++) {
+    dux::FVec2 start = RandFVec2(-500_fx, 1500_fx, -500_fx, 1500_fx);
+    dux::FVec2 end = RandFVec2(-500_fx, 1500_fx, -500_fx, 1500_fx);
+    AssertVecEqual(VisitedPositions(start, end, {10, 7}),
+                   Walk(start, end, {10, 7}));
+  }
+
+  // The walk stops when the visitor returns false.
+  for (int i = 0; i < 1000; i++) {
+    dux::FVec2 start = RandFVec2(0_fx, 1000_fx, 0_fx, 1000_fx);
+    dux::FVec2 end = RandFVec2(0_fx, 1000_fx, 0_fx, 1000_fx);
+    std::vector<GridPosition> positions = Walk(start, end, {100, 100});
+    size_t stop = static_cast<size_t>(i) % positions.size();
+    std::vector<GridPosition> visited;
+    bool completed =
+        WalkVisit(start, end, {100, 100}, [&](GridPosition p) {
+          visited.push_back(p);
+          return visited.size() <= stop;
+        });
+    assert(!completed);
+    positions.resize(stop + 1);
+    AssertVecEqual(visited, positions);
+  }
+}
+
+// Returns |positions| translated by |offset|.
+std::vector<GridPosition> Translated(std::vector<GridPosition> positions,
+                                     GridPosition offset) {
+  for (GridPosition& p : positions) {
+    p.x_ += offset.x_;
+    p.y_ += offset.y_;
+  }
+  return positions;
+}
+
+void TestGridSpec() {
+  // Test |PositionOf|, |OffsetInCell| and |CornerOf|, with and without
+  // shifts.
+  constexpr GridSpec shifted({10, 10}, 16_fx, FVec2(-100_fx, 3_fx));
+  static_assert(shifted.PositionOf(FVec2(-100_fx, 3_fx)) ==
+                GridPosition{0, 0});
+  static_assert(shifted.PositionOf(FVec2(-101_fx, 19_fx)) ==
+                GridPosition{-1, 1});
+  static_assert(shifted.OffsetInCell(FVec2(-101_fx, 20_fx)) ==
+                FVec2(15_fx, 1_fx));
+  constexpr GridSpec divided({10, 10}, 10_fx, FVec2(-100_fx, 3_fx));
+  static_assert(divided.PositionOf(FVec2(-100_fx, 3_fx)) ==
+                GridPosition{0, 0});
+  static_assert(divided.PositionOf(FVec2(-101_fx, 13_fx)) ==
+                GridPosition{-1, 1});
+  static_assert(divided.OffsetInCell(FVec2(-101_fx, 14_fx)) ==
+                FVec2(9_fx, 1_fx));
+  static_assert(divided.CornerOf({-1, 1}) == FVec2(-110_fx, 13_fx));
+  // The squares whose coordinates do not fit in 32 bits are clamped.
+  constexpr FInt kFar = FInt::FromRawValue(int64_t(1) << 60);
+  static_assert(shifted.PositionOf(FVec2(kFar, -kFar)) ==
+                GridPosition{std::numeric_limits<int32_t>::max(),
+                             std::numeric_limits<int32_t>::min()});
+  for (int i = 0; i < 1000; i++) {
+    FVec2 v = RandFVec2(-100000_fx, 100000_fx, -100000_fx, 100000_fx);
+    assert(GridSpec({1, 1}).PositionOf(v) == GridPositionFromFVec2(v));
+  }
+
+  for (int i = 0; i < 1000; i++) {
+    FVec2 start = RandFVec2(-500_fx, 3000_fx, -500_fx, 3000_fx);
+    FVec2 end = RandFVec2(-500_fx, 3000_fx, -500_fx, 3000_fx);
+    // Moving the origin is the same as moving the points.
+    FVec2 origin = RandFVec2(-500_fx, 500_fx, -500_fx, 500_fx);
+    AssertVecEqual(Walk(start, end, GridSpec({40, 40}, 64_fx, origin)),
+                   Walk(start - origin, end - origin, {40, 40}));
+
+    // Changing the size of the squares is the same as scaling the points,
+    // when the products are exact.
+    FVec2 integer_start(start.x_.Int64(), start.y_.Int64());
+    FVec2 integer_end(end.x_.Int64(), end.y_.Int64());
+    AssertVecEqual(
+        Walk(integer_start * 2, integer_end * 2, GridSpec({40, 40}, 128_fx,
+                                                          FVec2(0_fx, 0_fx))),
+        Walk(integer_start, integer_end, {40, 40}));
+    AssertVecEqual(
+        Walk(integer_start * 3, integer_end * 3, GridSpec({40, 40}, 48_fx,
+                                                          FVec2(0_fx, 0_fx))),
+        Walk(integer_start * 4, integer_end * 4, {40, 40}));
+    std::vector<GridPosition> visited;
+    WalkVisit(integer_start * 3, integer_end * 3,
+              GridSpec({40, 40}, 48_fx, FVec2(0_fx, 0_fx)),
+              [&visited](GridPosition p) {
+                visited.push_back(p);
+                return true;
+              });
+    AssertVecEqual(visited, Walk(integer_start * 4, integer_end * 4, {40, 40}));
+
+    // Grids wider than 2^15 squares, far from the origin.
+    FVec2 positive(500_fx, 500_fx);
+    FInt far = FInt::FromRawValue(int64_t(64) << (30 + FInt::kShift));
+    FVec2 far_offset = positive + FVec2(far, far);
+    constexpr int32_t kMaxWidth = std::numeric_limits<int32_t>::max();
+    GridSpec large({kMaxWidth, kMaxWidth}, 64_fx, FVec2(0_fx, 0_fx));
+    AssertVecEqual(Walk(start + far_offset, end + far_offset, large),
+                   Translated(Walk(start + positive, end + positive,
+                                   {1 << 16, 1 << 16}),
+                              {1 << 30, 1 << 30}));
+  }
+}
+
+void TestWalkMany() {
+  WalkBuffer buffer;
+  // Pools reused by all the calls.
+  std::vector<std::unique_ptr<ThreadPool>> pools;
+  for (int thread_count : {1, 2, 3, 8}) {
+    pools.push_back(std::make_unique<ThreadPool>(thread_count));
+  }
+  for (size_t count : {size_t(100), size_t(0), size_t(20), size_t(300)}) {
+    std::vector<FVec2> starts;
+    std::vector<FVec2> ends;
+    for (size_t i = 0; i < count; i++) {
+      starts.push_back(RandFVec2(-500_fx, 3000_fx, -500_fx, 3000_fx));
+      ends.push_back(RandFVec2(-500_fx, 3000_fx, -500_fx, 3000_fx));
+      if (i % 5 == 0) {
+        ends.back().y_ = starts.back().y_;
+      }
+    }
+    // Reuses the buffer of the previous iteration.
+    WalkMany(starts.data(), ends.data(), count, {40, 30}, buffer);
+    assert(buffer.LineCount() == count);
+    for (size_t i = 0; i < count; i++) {
+      AssertVecEqual(
+          std::vector<GridPosition>(buffer.LineBegin(i), buffer.LineEnd(i)),
+          Walk(starts[i], ends[i], {40, 30}));
+      assert(buffer.LineSize(i) == Walk(starts[i], ends[i], {40, 30}).size());
+    }
+    GridSpec spec({40, 30}, 20_fx, FVec2(-100_fx, 0_fx));
+    WalkMany(starts.data(), ends.data(), count, spec, buffer);
+    for (size_t i = 0; i < count; i++) {
+      AssertVecEqual(
+          std::vector<GridPosition>(buffer.LineBegin(i), buffer.LineEnd(i)),
+          Walk(starts[i], ends[i], spec));
+    }
+
+    // The buffer is the same whatever the number of threads.
+    for (std::unique_ptr<ThreadPool> const& pool : pools) {
+      WalkBuffer threaded_buffer;
+      WalkMany(starts.data(), ends.data(), count, spec, threaded_buffer,
+               pool.get());
+      AssertVecEqual(threaded_buffer.positions_, buffer.positions_);
+      assert(threaded_buffer.offsets_ == buffer.offsets_);
+    }
+  }
+}
+
+void TestGridWalker() {
+  for (int i = 0; i < 2000; i++) {
+    FVec2 start = RandFVec2(-500_fx, 3000_fx, -500_fx, 3000_fx);
+    FVec2 end = RandFVec2(-500_fx, 3000_fx, -500_fx, 3000_fx);
+    if (i % 5 == 0) {
+      end.x_ = start.x_;
+    }
+    GridSpec spec = i % 2 ? GridSpec({40, 30})
+                          : GridSpec({40, 30}, 48_fx, FVec2(-50_fx, 20_fx));
+    std::vector<GridPosition> expected = Walk(start, end, spec);
+
+    // Range-based for loop, left and resumed.
+    GridWalker walker(start, end, spec);
+    std::vector<GridPosition> walked;
+    for (GridPosition p : walker) {
+      walked.push_back(p);
+      if (walked.size() == static_cast<size_t>(i % 7)) {
+        break;
+      }
+    }
+    for (GridPosition p : walker) {
+      walked.push_back(p);
+    }
+    assert(walker.Done());
+    AssertVecEqual(walked, expected);
+
+    // Fixed budget per call.
+    GridWalker budgeted_walker(start, end, spec);
+    walked.clear();
+    int64_t budget = i % 10 + 1;
+    int64_t calls = 0;
+    while (!budgeted_walker.Resume(budget, [&walked](GridPosition p) {
+      walked.push_back(p);
+      return true;
+    })) {
+      calls++;
+      assert(calls < 1000);
+    }
+    AssertVecEqual(walked, expected);
+
+    // |Next|, and the visitor pausing the walk.
+    GridWalker paused_walker(start, end, spec);
+    walked.clear();
+    GridPosition next;
+    if (paused_walker.Next(next)) {
+      walked.push_back(next);
+    }
+    while (!paused_walker.Resume(1000, [&walked](GridPosition p) {
+      walked.push_back(p);
+      return walked.size() % 3 != 0;
+    })) {
+    }
+    assert(!paused_walker.Next(next));
+    AssertVecEqual(walked, expected);
+  }
+}
+
+// Returns true if |value| is in [begin - 2, end + 2], in raw values.
+bool IsInRange(FInt value, FInt begin, FInt end) {
+  return value.raw_value_ >= begin.raw_value_ - 2 &&
+         value.raw_value_ <= end.raw_value_ + 2;
+}
+
+void TestRaycastFirst() {
+  auto is_blocked = [](GridPosition p) {
+    return (p.x_ * 7 + p.y_ * 3) % 23 == 0;
+  };
+  for (int i = 0; i < 5000; i++) {
+    FVec2 start = RandFVec2(-500_fx, 3000_fx, -500_fx, 3000_fx);
+    FVec2 end = RandFVec2(-500_fx, 3000_fx, -500_fx, 3000_fx);
+    if (i % 5 == 0) {
+      // Nearly vertical lines.
+      end.x_ = start.x_ + FInt::FromRawValue(i % 300);
+    }
+    GridSpec spec = i % 2 ? GridSpec({40, 30})
+                          : GridSpec({40, 30}, 48_fx, FVec2(-50_fx, 20_fx));
+    std::vector<GridPosition> walked = Walk(start, end, spec);
+    auto first = std::find_if(walked.begin(), walked.end(), is_blocked);
+    std::optional<RaycastHit> hit = RaycastFirst(start, end, spec, is_blocked);
+    assert(hit.has_value() == (first != walked.end()));
+    if (!hit) {
+      continue;
+    }
+    assert(hit->position_ == *first);
+    if (hit->position_ == spec.PositionOf(start)) {
+      assert(hit->point_ == start);
+      assert(hit->t_ == 0_fx);
+      continue;
+    }
+
+    // The entry point is on the border of the square...
+    FVec2 point = hit->point_;
+    FVec2 corner = spec.CornerOf(hit->position_);
+    FVec2 far_corner = corner + FVec2(spec.CellSize(), spec.CellSize());
+    bool on_x_border = point.x_ == corner.x_ || point.x_ == far_corner.x_;
+    bool on_y_border = point.y_ == corner.y_ || point.y_ == far_corner.y_;
+    assert((on_x_border && IsInRange(point.y_, corner.y_, far_corner.y_)) ||
+           (on_y_border && IsInRange(point.x_, corner.x_, far_corner.x_)));
+    // ...on the line, up to the rounding...
+    double x = point.x_.DoubleValue() - start.x_.DoubleValue();
+    double y = point.y_.DoubleValue() - start.y_.DoubleValue();
+    double dx = (end.x_ - start.x_).DoubleValue();
+    double dy = (end.y_ - start.y_).DoubleValue();
+    double length = std::sqrt(dx * dx + dy * dy);
+    double raw_unit = FInt::FromRawValue(1).DoubleValue();
+    assert(std::abs(x * dy - y * dx) / length <= 2 * raw_unit);
+    // ...and at |t_| along it.
+    double t = hit->t_.DoubleValue();
+    assert(t >= 0 && t <= 1);
+    assert(std::hypot(dx * t - x, dy * t - y) <= (length + 2) * raw_unit);
+  }
+}
+
 }  // namespace
 
 void TestGridWalking() {
@@ -167,4 +455,10 @@ void TestGridWalking() {
       }
     }
   }
+
+  TestWalkVisit();
+  TestGridSpec();
+  TestWalkMany();
+  TestGridWalker();
+  TestRaycastFirst();
 }
@@ -0,0 +1,115 @@
+#include "test_line_of_sight.h"
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include "line_of_sight.h"
+#include "thread_pool.h"
+#include "utils.h"
+
+using namespace dux;
+using namespace dux_test_utils;
+
+namespace {
+
+// Returns true if none of the positions returned by |Walk| is blocked.
+bool IsVisibleWithWalk(LineOfSight const& grid, FVec2 start, FVec2 end) {
+  for (GridPosition const& position : Walk(start, end, grid.Spec())) {
+    if (grid.IsBlocked(position)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Blocks about one square out of |ratio|.
+void BlockRandomSquares(LineOfSight& grid, int32_t ratio) {
+  GridSize size = grid.Size();
+  for (int32_t i = 0; i < size.width_ * size.height_ / ratio; i++) {
+    FVec2 v = RandFVec2(0_fx, FInt::FromInt(size.width_ - 1), 0_fx,
+                        FInt::FromInt(size.height_ - 1));
+    grid.SetBlocked({v.x_.Int32(), v.y_.Int32()}, true);
+  }
+}
+
+}  // namespace
+
+void TestLineOfSight() {
+  // Test |SetBlocked| and |IsBlocked| around the boundaries of the words.
+  LineOfSight grid({130, 3});
+  for (int32_t x : {0, 63, 64, 65, 127, 128, 129}) {
+    assert(!grid.IsBlocked({x, 1}));
+    grid.SetBlocked({x, 1}, true);
+    assert(grid.IsBlocked({x, 1}));
+    assert(!grid.IsBlocked({x, 0}) && !grid.IsBlocked({x, 2}));
+  }
+  grid.SetBlocked({64, 1}, false);
+  assert(!grid.IsBlocked({64, 1}));
+  assert(grid.IsBlocked({63, 1}) && grid.IsBlocked({65, 1}));
+  grid.Clear();
+  for (int32_t x = 0; x < 130; x++) {
+    assert(!grid.IsBlocked({x, 1}));
+  }
+
+  // Lines along a row, whose squares are tested 64 at a time.
+  grid.SetBlocked({100, 1}, true);
+  assert(grid.IsVisible({64_fx, 64_fx}, {6399_fx, 127_fx}));
+  assert(!grid.IsVisible({64_fx, 64_fx}, {6400_fx, 127_fx}));
+  assert(!grid.IsVisible({8000_fx, 100_fx}, {6400_fx, 127_fx}));
+  assert(grid.IsVisible({8000_fx, 100_fx}, {6464_fx, 127_fx}));
+  assert(!grid.IsVisible({-1000_fx, 100_fx}, {10000_fx, 100_fx}));
+  assert(grid.IsVisible({-1000_fx, 0_fx}, {10000_fx, 0_fx}));
+
+  // Grids of other |GridSpec|s.
+  for (GridSpec const& spec :
+       {GridSpec({50, 40}, 16_fx, FVec2(-300_fx, 100_fx)),
+        GridSpec({50, 40}, FInt::FromFraction(25, 2), FVec2(10_fx, -7_fx))}) {
+    LineOfSight spec_grid(spec);
+    BlockRandomSquares(spec_grid, 20);
+    for (int i = 0; i < 1000; i++) {
+      FVec2 start = RandFVec2(-400_fx, 700_fx, -100_fx, 800_fx);
+      FVec2 end = RandFVec2(-400_fx, 700_fx, -100_fx, 800_fx);
+      assert(spec_grid.IsVisible(start, end) ==
+             IsVisibleWithWalk(spec_grid, start, end));
+    }
+  }
+
+  // Same results as |Walk|, including for the lines leaving the grid.
+  // Pools reused by all the calls of |VisibleMask|.
+  ThreadPool pool_1(1);
+  ThreadPool pool_3(3);
+  ThreadPool pool_4(4);
+  for (int32_t ratio : {2, 10, 50}) {
+    LineOfSight random_grid({200, 150});
+    BlockRandomSquares(random_grid, ratio);
+    for (int i = 0; i < 2000; i++) {
+      FVec2 start = RandFVec2(-1000_fx, 14000_fx, -1000_fx, 10000_fx);
+      FVec2 end = RandFVec2(-1000_fx, 14000_fx, -1000_fx, 10000_fx);
+      if (i % 4 == 0) {
+        end.y_ = start.y_;
+      } else if (i % 4 == 1) {
+        end.x_ = start.x_;
+      }
+      assert(random_grid.IsVisible(start, end) ==
+             IsVisibleWithWalk(random_grid, start, end));
+    }
+
+    // Test |VisibleMask|, with and without threads.
+    FVec2 origin = RandFVec2(0_fx, 12800_fx, 0_fx, 9600_fx);
+    std::vector<FVec2> targets;
+    for (int i = 0; i < 1000; i++) {
+      targets.push_back(RandFVec2(0_fx, 12800_fx, 0_fx, 9600_fx));
+    }
+    for (ThreadPool* pool : {static_cast<ThreadPool*>(nullptr), &pool_1,
+                             &pool_3, &pool_4}) {
+      std::unique_ptr<bool[]> visible(new bool[targets.size()]);
+      random_grid.VisibleMask(origin, targets.data(), targets.size(),
+                              visible.get(), pool);
+      for (size_t i = 0; i < targets.size(); i++) {
+        assert(visible[i] ==
+               IsVisibleWithWalk(random_grid, origin, targets[i]));
+      }
+    }
+  }
+}
@@ -0,0 +1,6 @@
+#ifndef DUX_FILED_TEST_TEST_LINE_OF_SIGHT_H_
+#define DUX_FILED_TEST_TEST_LINE_OF_SIGHT_H_
+
+void TestLineOfSight();
+
+#endif  // DUX_FILED_TEST_TEST_LINE_OF_SIGHT_H_
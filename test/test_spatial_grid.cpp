@@ -0,0 +1,123 @@
+#include "test_spatial_grid.h"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "spatial_grid.h"
+#include "utils.h"
+
+using namespace dux;
+using namespace dux_test_utils;
+
+namespace {
+
+void AssertSameIds(std::vector<uint32_t> a, std::vector<uint32_t> b) {
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+  assert(a == b);
+}
+
+// Compares the queries of |grid| with the ones of a linear search in the
+// entities whose ids are |ids| and positions are |positions|.
+void VerifyQueries(SpatialGrid const& grid,
+                   std::vector<uint32_t> const& ids,
+                   std::vector<FVec2> const& positions) {
+  for (int i = 0; i < 200; i++) {
+    FVec2 center = RandFVec2(-500_fx, 3000_fx, -500_fx, 3000_fx);
+    FInt radius = RandFVec2(0_fx, 300_fx, 0_fx, 0_fx).x_;
+    std::vector<uint32_t> expected;
+    for (size_t j = 0; j < positions.size(); j++) {
+      if (positions[j].SquareLengthFrom(center) <= radius * radius) {
+        expected.push_back(ids[j]);
+      }
+    }
+    std::vector<uint32_t> found;
+    grid.QueryRadius(center, radius, found);
+    AssertSameIds(found, expected);
+
+    FVec2 corner = RandFVec2(-500_fx, 3000_fx, -500_fx, 3000_fx);
+    FVec2 min(std::min(center.x_, corner.x_), std::min(center.y_, corner.y_));
+    FVec2 max(std::max(center.x_, corner.x_), std::max(center.y_, corner.y_));
+    expected.clear();
+    for (size_t j = 0; j < positions.size(); j++) {
+      if (positions[j] >= min && positions[j] <= max) {
+        expected.push_back(ids[j]);
+      }
+    }
+    found.clear();
+    grid.QueryBox(min, max, found);
+    AssertSameIds(found, expected);
+  }
+}
+
+}  // namespace
+
+void TestSpatialGrid() {
+  // Entities on the boundaries of the squares and of the radius.
+  SpatialGrid grid({4, 4});
+  std::vector<FVec2> positions = {{0_fx, 0_fx},   {64_fx, 0_fx},
+                                  {63_fx, 63_fx}, {100_fx, 0_fx},
+                                  {-5_fx, 0_fx},  {1000_fx, 1000_fx}};
+  grid.Build(positions.data(), positions.size());
+  assert(grid.Size() == 6);
+  std::vector<uint32_t> found;
+  grid.QueryRadius({0_fx, 0_fx}, 64_fx, found);
+  AssertSameIds(found, {0, 1, 4});
+  found.clear();
+  grid.QueryBox({0_fx, 0_fx}, {64_fx, 63_fx}, found);
+  AssertSameIds(found, {0, 1, 2});
+  // Entities outside of the grid are found too.
+  found.clear();
+  grid.QueryRadius({1000_fx, 1001_fx}, 1_fx, found);
+  AssertSameIds(found, {5});
+  // Even more than 2^31 squares away, where the columns do not fit in 32
+  // bits: (2^32 + 1, 0) is stored in the square (3, 0), not (1, 0).
+  SpatialGrid far_grid({4, 4});
+  FInt far = FInt::FromRawValue(((int64_t(1) << 32) + 1) * 64 * 4096);
+  std::vector<FVec2> far_positions = {{far, 0_fx}, {-far, 200_fx}};
+  far_grid.Build(far_positions.data(), far_positions.size());
+  found.clear();
+  far_grid.QueryBox({64_fx, 0_fx}, {127_fx, 63_fx}, found);
+  assert(found.empty());
+  far_grid.QueryBox({far - 1_fx, -1_fx}, {far + 1_fx, 1_fx}, found);
+  AssertSameIds(found, {0});
+  found.clear();
+  far_grid.QueryBox({-far - 1_fx, 199_fx}, {-far + 1_fx, 201_fx}, found);
+  AssertSameIds(found, {1});
+  // The visitor receives the positions.
+  grid.QueryRadius({63_fx, 63_fx}, 0_fx, [](uint32_t id, FVec2 const& p) {
+    assert(id == 2);
+    assert(p == FVec2(63_fx, 63_fx));
+  });
+
+  // Grids without squares hold no entity.
+  for (GridSize size : {GridSize{0, 0}, GridSize{0, 5}, GridSize{5, 0}}) {
+    SpatialGrid empty_grid(size);
+    empty_grid.Build(positions.data(), positions.size());
+    assert(empty_grid.Size() == 0);
+    found.clear();
+    empty_grid.QueryRadius({0_fx, 0_fx}, 2000_fx, found);
+    empty_grid.QueryBox({-10_fx, -10_fx}, {2000_fx, 2000_fx}, found);
+    assert(found.empty());
+  }
+
+  // Random entities on grids of several |GridSpec|s, rebuilt several times.
+  for (GridSpec const& spec :
+       {GridSpec({40, 40}), GridSpec({7, 30}, 100_fx, FVec2(-200_fx, 50_fx)),
+        GridSpec({100, 1}, FInt::FromFraction(77, 3), FVec2(0_fx, 0_fx))}) {
+    SpatialGrid random_grid(spec);
+    for (size_t count : {size_t(0), size_t(1), size_t(500), size_t(2000)}) {
+      std::vector<uint32_t> ids;
+      std::vector<FVec2> random_positions;
+      for (size_t i = 0; i < count; i++) {
+        ids.push_back(static_cast<uint32_t>(i * 7 + 3));
+        random_positions.push_back(
+            RandFVec2(-1000_fx, 3500_fx, -1000_fx, 3500_fx));
+      }
+      random_grid.Build(ids.data(), random_positions.data(), count);
+      assert(random_grid.Size() == count);
+      VerifyQueries(random_grid, ids, random_positions);
+    }
+  }
+}
@@ -0,0 +1,6 @@
+#ifndef DUX_FILED_TEST_TEST_SPATIAL_GRID_H_
+#define DUX_FILED_TEST_TEST_SPATIAL_GRID_H_
+
+void TestSpatialGrid();
+
+#endif  // DUX_FILED_TEST_TEST_SPATIAL_GRID_H_
@@ -0,0 +1,59 @@
+#include "test_thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "parallel_for.h"
+#include "thread_pool.h"
+
+using namespace dux;
+
+void TestThreadPool() {
+  for (int thread_count : {-1, 0, 1, 2, 5}) {
+    ThreadPool pool(thread_count);
+    assert(pool.ThreadCount() == std::max(thread_count, 1));
+
+    // Each call of |Run| calls the work from the requested number of
+    // threads, clamped to the threads of the pool, and the pool is reused.
+    for (int run = 0; run < 200; run++) {
+      int requested = run % 7 - 1;
+      std::mutex mutex;
+      std::set<std::thread::id> threads;
+      int calls = 0;
+      auto work = [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.insert(std::this_thread::get_id());
+        calls++;
+      };
+      pool.Run(requested, work);
+      int expected = std::min(std::max(requested, 1), pool.ThreadCount());
+      assert(calls == expected);
+      assert(static_cast<int>(threads.size()) == expected);
+      assert(threads.count(std::this_thread::get_id()) == 1);
+    }
+
+    // |internal::ParallelFor| covers each index once, with or without pool.
+    for (size_t count : {size_t(0), size_t(10), size_t(1000)}) {
+      std::vector<std::atomic<int>> visits(count);
+      internal::ParallelFor(count, 16, &pool, [&](size_t begin, size_t end) {
+        assert(end - begin <= 16);
+        for (size_t i = begin; i < end; i++) {
+          visits[i]++;
+        }
+      });
+      internal::ParallelFor(count, 16, nullptr, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          visits[i]++;
+        }
+      });
+      for (std::atomic<int> const& visit : visits) {
+        assert(visit == 2);
+      }
+    }
+  }
+}
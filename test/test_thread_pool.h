@@ -0,0 +1,6 @@
+#ifndef DUX_FILED_TEST_TEST_THREAD_POOL_H_
+#define DUX_FILED_TEST_TEST_THREAD_POOL_H_
+
+void TestThreadPool();
+
+#endif  // DUX_FILED_TEST_TEST_THREAD_POOL_H_